@@ -0,0 +1,93 @@
+#include <parallel_primitives/reduction.hpp>
+#include <parallel_primitives/scan_decoupled_lookback.hpp>
+#include <benchmark/benchmark.h>
+#include <usm_smart_ptr.hpp>
+
+using namespace usm_smart_ptr;
+using namespace parallel_primitives;
+
+/**
+ * Software prefetch distance sweep on the CPU device. Its kernels are SPIR-V device code, where sycl::ext::prefetch
+ * lowers to the OpenCL prefetch. The distance 0 runs are the baseline without prefetches.
+ */
+template<size_t prefetch_distance>
+void reduce_prefetch_cpu(benchmark::State &state) {
+    using T = uint32_t;
+    static sycl::queue q{sycl::cpu_selector{}};
+    auto in = usm_unique_ptr<T, alloc::device>(state.range(0), q);
+
+    q.fill(in.get(), T(1), in.size()).wait();
+
+    T res;
+    for (auto _: state) {
+        res = reduce_device<sycl::plus<>, T, true, 16384, prefetch_distance>(q, in.get_span());
+    }
+
+    state.SetBytesProcessed(state.iterations() * in.size_bytes());
+    std::stringstream str;
+    str << "Result: " << res << " expected: " << in.size();
+    state.SetLabel(str.str());
+}
+
+template<size_t prefetch_distance>
+void scan_prefetch_cpu(benchmark::State &state) {
+    using T = uint32_t;
+    static sycl::queue q{sycl::cpu_selector{}};
+    auto size = static_cast<size_t>(state.range(0));
+    auto in = usm_unique_ptr<T, alloc::device>(size, q);
+    auto out = usm_unique_ptr<T, alloc::device>(size, q);
+
+    q.fill(in.get(), T(1), in.size()).wait();
+
+    for (auto _: state) {
+        scan_device<scan_type::inclusive, sycl::plus<>, T, prefetch_distance>(q, in.get(), out.get(), size, group_scan_algorithm::raking);
+    }
+
+    state.SetBytesProcessed(static_cast<int64_t>(state.iterations() * in.size_bytes()));
+    std::stringstream str;
+    T out_v;
+    q.memcpy(&out_v, out.get() + size - 1, sizeof(T)).wait();
+    str << "Result: " << out_v << " expected: " << size;
+    state.SetLabel(str.str());
+}
+
+template<size_t prefetch_distance>
+void decoupled_scan_prefetch_cpu(benchmark::State &state) {
+    using T = uint32_t;
+    static sycl::queue q{sycl::cpu_selector{}};
+    auto size = static_cast<size_t>(state.range(0));
+    auto in = usm_unique_ptr<T, alloc::device>(size, q);
+    auto out = usm_unique_ptr<T, alloc::device>(size, q);
+
+    q.fill(in.get(), T(1), in.size()).wait();
+
+    for (auto _: state) {
+        // The raking scan is the one streaming its partitions through group_load
+        decoupled_scan_device<scan_type::inclusive, sycl::plus<>, T, false, prefetch_distance>(q, in.get(), out.get(), size, group_scan_algorithm::raking);
+    }
+
+    state.SetBytesProcessed(static_cast<int64_t>(state.iterations() * in.size_bytes()));
+    std::stringstream str;
+    T out_v;
+    q.memcpy(&out_v, out.get() + size - 1, sizeof(T)).wait();
+    str << "Result: " << out_v << " expected: " << size;
+    state.SetLabel(str.str());
+}
+
+BENCHMARK_TEMPLATE(reduce_prefetch_cpu, 0)->Unit(benchmark::kMillisecond)->RangeMultiplier(4)->Range(1 << 20, 1 << 28);
+BENCHMARK_TEMPLATE(reduce_prefetch_cpu, 1)->Unit(benchmark::kMillisecond)->RangeMultiplier(4)->Range(1 << 20, 1 << 28);
+BENCHMARK_TEMPLATE(reduce_prefetch_cpu, 2)->Unit(benchmark::kMillisecond)->RangeMultiplier(4)->Range(1 << 20, 1 << 28);
+BENCHMARK_TEMPLATE(reduce_prefetch_cpu, 4)->Unit(benchmark::kMillisecond)->RangeMultiplier(4)->Range(1 << 20, 1 << 28);
+
+BENCHMARK_TEMPLATE(scan_prefetch_cpu, 0)->Unit(benchmark::kMillisecond)->RangeMultiplier(4)->Range(1 << 20, 1 << 28);
+BENCHMARK_TEMPLATE(scan_prefetch_cpu, 1)->Unit(benchmark::kMillisecond)->RangeMultiplier(4)->Range(1 << 20, 1 << 28);
+BENCHMARK_TEMPLATE(scan_prefetch_cpu, 2)->Unit(benchmark::kMillisecond)->RangeMultiplier(4)->Range(1 << 20, 1 << 28);
+BENCHMARK_TEMPLATE(scan_prefetch_cpu, 4)->Unit(benchmark::kMillisecond)->RangeMultiplier(4)->Range(1 << 20, 1 << 28);
+
+BENCHMARK_TEMPLATE(decoupled_scan_prefetch_cpu, 0)->Unit(benchmark::kMillisecond)->RangeMultiplier(4)->Range(1 << 20, 1 << 28);
+BENCHMARK_TEMPLATE(decoupled_scan_prefetch_cpu, 1)->Unit(benchmark::kMillisecond)->RangeMultiplier(4)->Range(1 << 20, 1 << 28);
+BENCHMARK_TEMPLATE(decoupled_scan_prefetch_cpu, 2)->Unit(benchmark::kMillisecond)->RangeMultiplier(4)->Range(1 << 20, 1 << 28);
+BENCHMARK_TEMPLATE(decoupled_scan_prefetch_cpu, 4)->Unit(benchmark::kMillisecond)->RangeMultiplier(4)->Range(1 << 20, 1 << 28);
+
+// Run benchmark
+BENCHMARK_MAIN();
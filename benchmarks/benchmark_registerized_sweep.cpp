@@ -0,0 +1,142 @@
+#include <runtime_index_wrapper.hpp>
+#include <runtime_byte_array.hpp>
+#include <register_bit_array.hpp>
+#include <benchmark/benchmark.h>
+#include <fstream>
+#include <iostream>
+#include "container_access.hpp"
+#include "crossover_reporter.hpp"
+
+/**
+ * Sweeps N from 2 to 512 and the storage type from uint8_t to uint64_t for the registerized containers and their
+ * stack counterparts, on the CPU device, with uniform (same index for all the work-items) and divergent indices.
+ * Writes, per container, pattern and storage size, the largest N for which the registerized version is not slower
+ * than the stack one to registerized_crossovers.json, or to the path given with --crossover_json=<path>.
+ */
+constexpr size_t work_items = 1 << 18;
+
+static sycl::queue &get_queue() {
+    static sycl::queue q{sycl::cpu_selector{}};
+    return q;
+}
+
+/**
+ * N elements of type T
+ */
+template<typename T, size_t N>
+struct registerized_elements {
+    std::array<T, N> data{};
+
+    [[nodiscard]] T read(const uint &i) const { return sycl::ext::runtime_index_wrapper(data, i); }
+
+    void write(const uint &i, const uint &val) { sycl::ext::runtime_index_wrapper(data, i, (T) val); }
+};
+
+template<typename T, size_t N>
+struct stack_elements {
+    std::array<T, N> data{};
+
+    [[nodiscard]] T read(const uint &i) const { return data[i]; }
+
+    void write(const uint &i, const uint &val) { data[i] = (T) val; }
+};
+
+/**
+ * N bytes packed in words of type T
+ */
+template<typename T, size_t N>
+struct registerized_bytes {
+    runtime_byte_array<N, T> data{};
+
+    [[nodiscard]] uint8_t read(const uint &i) const { return data.read(i); }
+
+    void write(const uint &i, const uint &val) { data.write(i, (uint8_t) val); }
+};
+
+template<typename T, size_t N>
+struct stack_bytes {
+    std::array<uint8_t, N> data{};
+
+    [[nodiscard]] uint8_t read(const uint &i) const { return data[i]; }
+
+    void write(const uint &i, const uint &val) { data[i] = (uint8_t) val; }
+};
+
+/**
+ * N bits packed in words of type T. register_bit_array::test never resolves its index on the stack, see
+ * select_register_only_strategy, so this variant stays in registers at every size.
+ */
+template<typename T, size_t N>
+struct registerized_bits {
+    register_bit_array<N, T> data{};
+
+    [[nodiscard]] bool read(const uint &i) const { return data.test(i); }
+
+    void write(const uint &i, const uint &val) { data.write(i, val & 1); }
+};
+
+template<typename T, size_t N>
+struct stack_bits {
+    std::array<T, (N + 8 * sizeof(T) - 1) / (8 * sizeof(T))> data{};
+
+    [[nodiscard]] bool read(const uint &i) const { return (data[i / (8 * sizeof(T))] >> (i % (8 * sizeof(T)))) & 1; }
+
+    void write(const uint &i, const uint &val) {
+        T &word = data[i / (8 * sizeof(T))];
+        word = (word & ~(T{1} << (i % (8 * sizeof(T))))) | (T(val & 1) << (i % (8 * sizeof(T))));
+    }
+};
+
+template<template<typename, size_t> class registerized, template<typename, size_t> class stack, typename T, size_t N>
+void register_size(const std::string &family) {
+    for (const bool uniform: {true, false}) {
+        const std::string prefix = family + (uniform ? "_uniform" : "_divergent");
+        const std::string suffix = "/" + std::to_string(sizeof(T)) + "/" + std::to_string(N);
+        benchmark::RegisterBenchmark((prefix + "/registerized" + suffix).c_str(), [uniform](benchmark::State &state) {
+            container_access<registerized<T, N>, N>(state, get_queue(), work_items, uniform);
+        })->Unit(benchmark::kMicrosecond);
+        benchmark::RegisterBenchmark((prefix + "/stack" + suffix).c_str(), [uniform](benchmark::State &state) {
+            container_access<stack<T, N>, N>(state, get_queue(), work_items, uniform);
+        })->Unit(benchmark::kMicrosecond);
+    }
+}
+
+template<template<typename, size_t> class registerized, template<typename, size_t> class stack, typename T, size_t... N>
+void register_sweep(const std::string &family, std::integer_sequence<size_t, N...>) {
+    (register_size<registerized, stack, T, N>(family), ...);
+}
+
+template<template<typename, size_t> class registerized, template<typename, size_t> class stack>
+void register_container(const std::string &family) {
+    using swept_sizes = std::integer_sequence<size_t, 2, 4, 8, 16, 32, 64, 128, 256, 512>;
+    register_sweep<registerized, stack, uint8_t>(family, swept_sizes{});
+    register_sweep<registerized, stack, uint16_t>(family, swept_sizes{});
+    register_sweep<registerized, stack, uint32_t>(family, swept_sizes{});
+    register_sweep<registerized, stack, uint64_t>(family, swept_sizes{});
+}
+
+int main(int argc, char **argv) {
+    std::string json_path = "registerized_crossovers.json";
+    const std::string json_flag = "--crossover_json=";
+    for (int i = 1; i < argc; ++i) {
+        if (std::string(argv[i]).rfind(json_flag, 0) == 0) {
+            json_path = std::string(argv[i]).substr(json_flag.size());
+            std::copy(argv + i + 1, argv + argc, argv + i);
+            --argc;
+            break;
+        }
+    }
+
+    register_container<registerized_elements, stack_elements>("runtime_index_wrapper");
+    register_container<registerized_bytes, stack_bytes>("runtime_byte_array");
+    register_container<registerized_bits, stack_bits>("register_bit_array");
+
+    benchmark::Initialize(&argc, argv);
+    crossover_reporter reporter;
+    benchmark::RunSpecifiedBenchmarks(&reporter);
+
+    std::ofstream json(json_path);
+    reporter.write_json(json, get_queue().get_device().get_info<sycl::info::device::name>(), {"registerized"}, {"stack"});
+    std::cout << "Crossovers written to " << json_path << '\n';
+    return 0;
+}
@@ -0,0 +1,74 @@
+#include <runtime_index_wrapper.hpp>
+#include <benchmark/benchmark.h>
+#include <iostream>
+#include "container_access.hpp"
+#include "crossover_reporter.hpp"
+
+using sycl::ext::registerizer_strategy;
+using sycl::ext::runtime_index_wrapper;
+
+/**
+ * Sweeps N for the linear, binary search and stack strategies, with divergent indices, on the default device (select
+ * it with SYCL_DEVICE_FILTER). Prints the SYCL_EXT_REGISTERIZER_LINEAR_MAX and SYCL_EXT_REGISTERIZER_BINARY_SEARCH_MAX
+ * definitions that make registerizer_strategy::automatic follow the measured crossovers on this device.
+ */
+constexpr size_t work_items = 1 << 20;
+
+static sycl::queue &get_queue() {
+    static sycl::queue q{sycl::default_selector{}};
+    return q;
+}
+
+/**
+ * N elements of type T accessed with the strategy
+ */
+template<registerizer_strategy strategy, typename T, size_t N>
+struct strategy_elements {
+    std::array<T, N> data{};
+
+    [[nodiscard]] T read(const uint &i) const { return runtime_index_wrapper<strategy>(data, i); }
+
+    void write(const uint &i, const uint &val) { runtime_index_wrapper<strategy>(data, i, (T) val); }
+};
+
+template<registerizer_strategy strategy, typename T, size_t N>
+void registerizer_access(benchmark::State &state) {
+    container_access<strategy_elements<strategy, T, N>, N>(state, get_queue(), work_items, false); // Divergent
+}
+
+template<typename T, size_t N>
+void register_size() {
+    const std::string suffix = "/" + std::to_string(sizeof(T)) + "/" + std::to_string(N);
+    benchmark::RegisterBenchmark(("registerizer/linear" + suffix).c_str(), registerizer_access<registerizer_strategy::linear, T, N>)->Unit(benchmark::kMicrosecond);
+    benchmark::RegisterBenchmark(("registerizer/binary_search" + suffix).c_str(), registerizer_access<registerizer_strategy::binary_search, T, N>)->Unit(benchmark::kMicrosecond);
+    benchmark::RegisterBenchmark(("registerizer/stack" + suffix).c_str(), registerizer_access<registerizer_strategy::stack, T, N>)->Unit(benchmark::kMicrosecond);
+}
+
+template<typename T, size_t... N>
+void register_sweep(std::integer_sequence<size_t, N...>) {
+    (register_size<T, N>(), ...);
+}
+
+using swept_sizes = std::integer_sequence<size_t, 2, 4, 8, 16, 32, 64, 128, 256, 512>;
+
+int main(int argc, char **argv) {
+    register_sweep<uint8_t>(swept_sizes{});
+    register_sweep<uint16_t>(swept_sizes{});
+    register_sweep<uint32_t>(swept_sizes{});
+    register_sweep<uint64_t>(swept_sizes{});
+
+    benchmark::Initialize(&argc, argv);
+    crossover_reporter reporter;
+    benchmark::RunSpecifiedBenchmarks(&reporter);
+
+    std::stringstream linear, binary_search;
+    for (size_t bytes: {1, 2, 4, 8}) {
+        const char *separator = bytes == 1 ? "" : ", ";
+        linear << separator << reporter.last_winning_size({"registerizer", bytes}, {"linear"}, {"binary_search", "stack"});
+        binary_search << separator << reporter.last_winning_size({"registerizer", bytes}, {"linear", "binary_search"}, {"stack"});
+    }
+    std::cout << "// " << get_queue().get_device().get_info<sycl::info::device::name>() << '\n'
+              << "#define SYCL_EXT_REGISTERIZER_LINEAR_MAX {" << linear.str() << "}\n"
+              << "#define SYCL_EXT_REGISTERIZER_BINARY_SEARCH_MAX {" << binary_search.str() << "}\n";
+    return 0;
+}
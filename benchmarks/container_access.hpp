@@ -0,0 +1,41 @@
+#pragma once
+
+#include <sycl/sycl.hpp>
+#include <benchmark/benchmark.h>
+
+/**
+ * Dependent read/write pairs done by each work-item of container_access
+ */
+constexpr uint container_access_iterations = 100;
+
+template<typename container, size_t N>
+class container_access_kernel;
+
+/**
+ * Times work_items work-items that each chain container_access_iterations reads and writes on their own default
+ * constructed container of N elements. container provides read(uint) and write(uint, uint). The indices are the same
+ * for all the work-items when uniform is set, else they diverge.
+ */
+template<typename container, size_t N>
+void container_access(benchmark::State &state, sycl::queue &q, size_t work_items, bool uniform) {
+    volatile uint *ptr = sycl::malloc_device<uint>(1, q);
+    q.memset((uint *) ptr, 0, sizeof(uint)).wait();
+
+    for (auto _: state) {
+        q.parallel_for<container_access_kernel<container, N>>(sycl::range<1>{work_items}, [=](sycl::id<1> id) {
+            container data{};
+            const uint init = *ptr;
+            const uint divergence = uniform ? 0 : (uint) id[0];
+            uint acc = 0;
+            for (uint c = 0; c < container_access_iterations; ++c) {
+                const uint idx = (c * 7 + divergence + init) % N;
+                acc += data.read(idx);
+                data.write((idx + acc) % N, acc + c);
+            }
+            if (acc == init + 1) *ptr = acc; // Keeps the accesses alive
+        }).wait();
+    }
+
+    state.SetItemsProcessed(static_cast<int64_t>(state.iterations() * work_items * container_access_iterations));
+    sycl::free((uint *) ptr, q);
+}
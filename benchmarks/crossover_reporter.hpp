@@ -0,0 +1,86 @@
+#pragma once
+
+#include <benchmark/benchmark.h>
+#include <algorithm>
+#include <limits>
+#include <map>
+#include <ostream>
+#include <sstream>
+#include <string>
+#include <vector>
+
+/**
+ * Console reporter that also records the runs named "<family>/<variant>/<element bytes>/<N>", to find the sizes N at
+ * which some variants stop being faster than the others.
+ */
+class crossover_reporter : public benchmark::ConsoleReporter {
+public:
+    using key_t = std::pair<std::string, size_t>; // Family, element bytes
+
+    void ReportRuns(const std::vector<Run> &reports) override {
+        for (const auto &run: reports) {
+            if (run.run_type != Run::RT_Iteration || run.iterations == 0) continue;
+            std::vector<std::string> parts;
+            std::stringstream name(run.benchmark_name());
+            for (std::string part; std::getline(name, part, '/');) {
+                parts.push_back(part);
+            }
+            if (parts.size() != 4) continue;
+            times_[{parts[0], std::stoul(parts[2])}][std::stoul(parts[3])][parts[1]] = run.GetAdjustedRealTime();
+        }
+        ConsoleReporter::ReportRuns(reports);
+    }
+
+    /**
+     * Largest measured N up to which the fastest of winners is never slower than the fastest of losers, 0 if they
+     * lose from the smallest size.
+     */
+    [[nodiscard]] size_t last_winning_size(const key_t &key, const std::vector<std::string> &winners, const std::vector<std::string> &losers) const {
+        const auto family = times_.find(key);
+        if (family == times_.end()) return 0;
+        size_t last = 0;
+        for (const auto &[n, variants]: family->second) {
+            if (best_time(variants, winners) > best_time(variants, losers)) break;
+            last = n;
+        }
+        return last;
+    }
+
+    /**
+     * Writes the crossover of every recorded family and element size as JSON, with the times in the benchmark unit
+     */
+    void write_json(std::ostream &os, const std::string &device, const std::vector<std::string> &winners, const std::vector<std::string> &losers) const {
+        os << "{\n  \"device\": \"" << device << "\",\n  \"crossovers\": [";
+        const char *separator = "\n";
+        for (const auto &[key, sizes]: times_) {
+            os << separator << "    {\"family\": \"" << key.first << "\", \"element_bytes\": " << key.second
+               << ", \"last_winning_size\": " << last_winning_size(key, winners, losers) << ", \"times\": {";
+            const char *size_separator = "";
+            for (const auto &[n, variants]: sizes) {
+                os << size_separator << "\"" << n << "\": {";
+                const char *variant_separator = "";
+                for (const auto &[variant, time]: variants) {
+                    os << variant_separator << "\"" << variant << "\": " << time;
+                    variant_separator = ", ";
+                }
+                os << "}";
+                size_separator = ", ";
+            }
+            os << "}}";
+            separator = ",\n";
+        }
+        os << "\n  ]\n}\n";
+    }
+
+private:
+    static double best_time(const std::map<std::string, double> &variants, const std::vector<std::string> &names) {
+        double best = std::numeric_limits<double>::infinity();
+        for (const auto &name: names) {
+            const auto it = variants.find(name);
+            if (it != variants.end()) best = std::min(best, it->second);
+        }
+        return best;
+    }
+
+    std::map<key_t, std::map<size_t, std::map<std::string, double>>> times_;
+};
@@ -0,0 +1,85 @@
+/**
+    Copyright 2021 Codeplay Software Ltd.
+
+    Licensed under the Apache License, Version 2.0 (the "License");
+    you may not use these files except in compliance with the License.
+    You may obtain a copy of the License at
+
+    http://www.apache.org/licenses/LICENSE-2.0
+
+    For your convenience, a copy of the License has been included in this
+    repository.
+
+    Unless required by applicable law or agreed to in writing, software
+    distributed under the License is distributed on an "AS IS" BASIS,
+    WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+    See the License for the specific language governing permissions and
+    limitations under the License.
+ */
+
+#pragma once
+
+#include <sycl/sycl.hpp>
+#include <intrinsics.hpp>
+
+#ifndef SYCL_IMPLEMENTATION_HIPSYCL
+
+namespace sycl::ext {
+
+    namespace internal {
+
+        /**
+         * Each round elects the first work-item not served yet, gathers the work-items sharing its key with a ballot,
+         * and the leader issues a single atomic for the sum of their values. The offsets inside the class come from an
+         * exclusive scan. The number of rounds is the number of distinct keys in the sub-group.
+         */
+        template<sycl::access::address_space space, typename T, typename K, typename func>
+        static inline T aggregated_atomic_add(const sycl::sub_group &sg, const K &key, const T &value, func &&get_address) {
+            using mask_t = sub_group_mask_t<>;
+            using atomic_ref_t = sycl::atomic_ref<T, sycl::memory_order::relaxed, sycl::memory_scope::device, space>;
+            const uint32_t local_range = sg.get_local_range().size();
+            const uint32_t lane = sg.get_local_linear_id();
+            mask_t remaining = local_range >= sizeof(mask_t) * 8 ? ~mask_t{0} : (mask_t{1} << local_range) - 1u;
+            T offset{};
+            while (remaining != 0) { // Uniform across the sub-group
+                const uint32_t leader = ctz64(remaining);
+                const bool is_peer = sycl::select_from_group(sg, key, leader) == key;
+                const T contribution = is_peer ? value : T{};
+                const T prefix = sycl::exclusive_scan_over_group(sg, contribution, sycl::plus<T>());
+                const T total = sycl::reduce_over_group(sg, contribution, sycl::plus<T>());
+                T base{};
+                if (lane == leader) {
+                    atomic_ref_t ref(*get_address(key));
+                    base = ref.fetch_add(total);
+                }
+                base = sycl::select_from_group(sg, base, leader);
+                if (is_peer) offset = base + prefix;
+                remaining &= ~ballot(sg, is_peer);
+            }
+            return offset;
+        }
+    }
+
+    /**
+     * Sub-group aggregated atomic add on *ptr, work-items targeting the same address share a single atomic. Must be called
+     * by the whole sub-group, a work-item with nothing to add passes 0.
+     * @return the value of *ptr this work-item would have seen with its own fetch_add, ie. its offset in an output buffer
+     */
+    template<sycl::access::address_space space = sycl::access::address_space::global_space, typename T>
+    static inline T aggregated_atomic_add(const sycl::sub_group &sg, T *ptr, const T &value) {
+        return internal::aggregated_atomic_add<space>(sg, reinterpret_cast<uintptr_t>(ptr), value, [=](const uintptr_t &) { return ptr; });
+    }
+
+    /**
+     * Keyed version of aggregated_atomic_add, adds value to ptr[key] (histogram bins, per-bucket cursors).
+     * @return the value of ptr[key] this work-item would have seen with its own fetch_add
+     */
+    template<sycl::access::address_space space = sycl::access::address_space::global_space, typename T, typename K>
+    static inline T aggregated_atomic_add(const sycl::sub_group &sg, T *ptr, const K &key, const T &value) {
+        static_assert(std::is_integral_v<K>);
+        return internal::aggregated_atomic_add<space>(sg, key, value, [=](const K &k) { return ptr + k; });
+    }
+
+}
+
+#endif
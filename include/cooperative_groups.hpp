@@ -20,16 +20,38 @@
 #pragma once
 
 #include <sycl/sycl.hpp>
+#include <intrinsics.hpp>
+#include "parallel_primitives/internal/common.h"
 #include <numeric>
+#include <algorithm>
+#include <limits>
+#include <optional>
 
 
 template<int dim>
 class nd_range_barrier {
+public:
+    /**
+     * Returned by arrive() and consumed by wait(). Only meaningful on the work-item that has the local id 0.
+     */
+    struct arrival_token {
+        uint32_t phase_ = 0;
+        bool participating_ = false;
+    };
+
 private:
     using mask_t = uint64_t;
-    mask_t groups_waiting_ = 0;
+    using atomic_ref_t = sycl::atomic_ref<
+            uint32_t,
+            sycl::memory_order::acq_rel,
+            sycl::memory_scope::device,
+            sycl::access::address_space::global_space
+    >;
+
     const mask_t barrier_mask_ = 0;
-    mask_t reached_ = 0;
+    const uint32_t participating_count_ = 0;
+    uint32_t arrived_ = 0;
+    uint32_t phase_ = 0;
 
     static mask_t compute_barrier_mask(size_t group_count, const std::vector<size_t> &cooperating_groups) {
         mask_t out = 0;
@@ -57,16 +79,24 @@ private:
         return out;
     }
 
+    static uint32_t compute_participating_count(mask_t mask) {
+        uint32_t count = 0;
+        for (; mask; ++count) {
+            mask &= mask - 1;
+        }
+        return count;
+    }
+
     static mask_t compute_item_mask(const sycl::nd_item<dim> &this_item) {
         return mask_t(1) << this_item.get_group_linear_id();
     }
 
 
-    void perform_check(sycl::queue &q, const sycl::nd_range<dim> &kernel_range) {
-        if (kernel_range.get_group_range().size() > sizeof(mask_t) * 8) {
+    void perform_check(sycl::queue &q, const sycl::nd_range<dim> &kernel_range, size_t groups_per_compute_unit) {
+        if (kernel_range.get_group_range().size() > max_group_count) {
             throw std::runtime_error("Not implemented.");
         }
-        if (kernel_range.get_group_range().size() > q.get_device().get_info<sycl::info::device::max_compute_units>()) {
+        if (kernel_range.get_group_range().size() > groups_per_compute_unit * q.get_device().get_info<sycl::info::device::max_compute_units>()) {
             throw std::runtime_error("Too much groups requested on cooperative barrier. Forward progress not guaranteed.");
         }
 
@@ -75,95 +105,501 @@ private:
         }
     }
 
-    nd_range_barrier(sycl::queue q, const sycl::nd_range<dim> &kernel_range, const std::vector<size_t> &cooperating_groups)
-            : barrier_mask_(compute_barrier_mask(kernel_range.get_group_range().size(), cooperating_groups)) {
-        perform_check(q, kernel_range);
+    nd_range_barrier(sycl::queue q, const sycl::nd_range<dim> &kernel_range, const std::vector<size_t> &cooperating_groups, size_t groups_per_compute_unit)
+            : barrier_mask_(compute_barrier_mask(kernel_range.get_group_range().size(), cooperating_groups)),
+              participating_count_(compute_participating_count(barrier_mask_)) {
+        perform_check(q, kernel_range, groups_per_compute_unit);
     }
 
     template<typename func>
-    nd_range_barrier(sycl::queue q, const sycl::nd_range<dim> &kernel_range, func &&predicate)
-            :barrier_mask_(compute_barrier_mask(kernel_range.get_group_range().size(), predicate)) {
-        perform_check(q, kernel_range);
+    nd_range_barrier(sycl::queue q, const sycl::nd_range<dim> &kernel_range, func &&predicate, size_t groups_per_compute_unit)
+            : barrier_mask_(compute_barrier_mask(kernel_range.get_group_range().size(), predicate)),
+              participating_count_(compute_participating_count(barrier_mask_)) {
+        perform_check(q, kernel_range, groups_per_compute_unit);
     }
 
 public:
 
+    static constexpr size_t max_group_count = sizeof(mask_t) * 8;
+
     /**
      * Constructor helpers
+     * @param groups_per_compute_unit number of groups that can be co-resident on a compute unit, @see get_occupancy
      */
     template<typename func>
-    static nd_range_barrier<dim> *make_barrier(sycl::queue &q, const sycl::nd_range<dim> &kernel_range, const func &predicate) {
+    static nd_range_barrier<dim> *make_barrier(sycl::queue &q, const sycl::nd_range<dim> &kernel_range, const func &predicate, size_t groups_per_compute_unit = 1) {
         auto barrier = sycl::malloc_shared<nd_range_barrier<dim>>(1, q);
-        return new(barrier) nd_range_barrier<dim>(q, kernel_range, predicate);
+        return new(barrier) nd_range_barrier<dim>(q, kernel_range, predicate, groups_per_compute_unit);
     }
 
 
-    static nd_range_barrier<dim> *make_barrier(sycl::queue &q, const sycl::nd_range<dim> &kernel_range, const std::vector<size_t> &cooperating_groups = {}) {
+    static nd_range_barrier<dim> *make_barrier(sycl::queue &q, const sycl::nd_range<dim> &kernel_range, const std::vector<size_t> &cooperating_groups = {}, size_t groups_per_compute_unit = 1) {
         auto barrier = sycl::malloc_shared<nd_range_barrier<dim>>(1, q);
-        return new(barrier) nd_range_barrier<dim>(q, kernel_range, cooperating_groups);
+        return new(barrier) nd_range_barrier<dim>(q, kernel_range, cooperating_groups, groups_per_compute_unit);
     }
 
-    void wait(sycl::nd_item<dim> this_item) {
+    /**
+     * First half of a split-phase barrier: signals that this group reached the barrier and returns immediately.
+     * The group can perform work that does not depend on the other groups before calling wait(token).
+     * Must be called by all the work-items of the group.
+     */
+    arrival_token arrive(sycl::nd_item<dim> this_item) {
+        arrival_token token{};
         const mask_t this_group_mask = compute_item_mask(this_item);
+        if ((this_group_mask & barrier_mask_) == 0) return token;
 
-        if ((this_group_mask & barrier_mask_) == 0) return;
-
-        this_item.barrier(sycl::access::fence_space::local_space);
+        token.participating_ = true;
+        this_item.barrier(sycl::access::fence_space::global_and_local);
         /* Choosing one work item to perform the work */
         if (this_item.get_local_linear_id() == 0) {
-            using atomic_ref_t = sycl::atomic_ref<
-                    mask_t,
-                    sycl::memory_order::relaxed, //TODO acq_rel
-                    sycl::memory_scope::device,
-                    sycl::access::address_space::global_space
-            >;
-            atomic_ref_t groups_waiting_ref(groups_waiting_);
-            atomic_ref_t barrier_reached_ref(reached_);
-
-            /* Waiting before entering the barrier */
-            while (barrier_reached_ref.load() != 0) {}
-
-            /* Registring this group at the barrier. */
-            groups_waiting_ref.fetch_or(this_group_mask);
-
-            if (groups_waiting_ref.load() == barrier_mask_) {
-                barrier_reached_ref.store(1);
-            } else {
-                while (barrier_reached_ref.load() != 1) {}
+            atomic_ref_t arrived_ref(arrived_);
+            atomic_ref_t phase_ref(phase_);
+
+            /* The phase has to be read before registering, the last group to arrive will increment it. */
+            token.phase_ = phase_ref.load();
+            if (arrived_ref.fetch_add(1) == participating_count_ - 1) {
+                /* Resetting the counter before releasing the phase so that early groups can already arrive on the next one. */
+                arrived_ref.store(0);
+                phase_ref.fetch_add(1);
             }
+        }
+        return token;
+    }
+
+    /**
+     * Second half of a split-phase barrier: blocks the group until all the cooperating groups called arrive().
+     * @param token value returned by the matching arrive()
+     */
+    void wait(sycl::nd_item<dim> this_item, const arrival_token &token) {
+        if (!token.participating_) return;
+
+        if (this_item.get_local_linear_id() == 0) {
+            atomic_ref_t phase_ref(phase_);
+            while (phase_ref.load() == token.phase_) {}
+        }
+
+        this_item.barrier(sycl::access::fence_space::global_and_local);
+    }
+
+    void wait(sycl::nd_item<dim> this_item) {
+        wait(this_item, arrive(this_item));
+    }
+};
+
+
+/**
+ * Grid-wide collectives built on top of nd_range_barrier. Each group publishes its aggregate in a slot array, and the slots
+ * are then combined in parallel by the work-items of the groups that need the result. The slots are double buffered so that
+ * only one barrier is needed per collective call.
+ * @tparam T type of the values exchanged
+ */
+template<typename T, int dim = 1>
+class nd_range_collectives {
+private:
+    nd_range_barrier<dim> *barrier_;
+    T *slots_;
+    uint32_t *parity_;
+    size_t group_count_;
+
+    nd_range_collectives(nd_range_barrier<dim> *barrier, T *slots, uint32_t *parity, size_t group_count)
+            : barrier_(barrier), slots_(slots), parity_(parity), group_count_(group_count) {}
+
+    /**
+     * Writes the value of the group leader in its slot and waits for the other groups.
+     * @return the slot array holding the values of every group
+     */
+    const T *publish(const sycl::nd_item<dim> &item, const T &group_value) {
+        const size_t group_id = item.get_group_linear_id();
+        const bool is_leader = item.get_local_linear_id() == 0;
+        const uint32_t parity = parity_[group_id];
+        T *slots = slots_ + parity * group_count_;
+        if (is_leader) slots[group_id] = group_value;
+        auto token = barrier_->arrive(item);
+        if (is_leader) parity_[group_id] = parity ^ 1u; // Every work-item of the group read the parity before arriving
+        barrier_->wait(item, token);
+        return slots;
+    }
+
+    /**
+     * Combines slots[0, count) using all the work-items of the group.
+     */
+    template<typename func>
+    static T combine(const sycl::nd_item<dim> &item, const T *slots, const size_t &count, const func &op) {
+        T acc = parallel_primitives::internal::get_init<T, func>();
+        for (size_t i = item.get_local_linear_id(); i < count; i += item.get_local_range().size()) {
+            acc = op(acc, slots[i]);
+        }
+        return sycl::reduce_over_group(item.get_group(), acc, op);
+    }
+
+public:
+
+    /**
+     * Constructor helper, the collectives must be released with free_collectives
+     * @param groups_per_compute_unit number of groups that can be co-resident on a compute unit, @see get_occupancy
+     */
+    static nd_range_collectives<T, dim> *make_collectives(sycl::queue &q, const sycl::nd_range<dim> &kernel_range, size_t groups_per_compute_unit = 1) {
+        const size_t group_count = kernel_range.get_group_range().size();
+        auto barrier = nd_range_barrier<dim>::make_barrier(q, kernel_range, {}, groups_per_compute_unit);
+        auto slots = sycl::malloc_shared<T>(2 * group_count, q);
+        auto parity = sycl::malloc_shared<uint32_t>(group_count, q);
+        q.fill(parity, uint32_t(0), group_count).wait();
+        auto collectives = sycl::malloc_shared<nd_range_collectives<T, dim>>(1, q);
+        return new(collectives) nd_range_collectives<T, dim>(barrier, slots, parity, group_count);
+    }
+
+    static void free_collectives(nd_range_collectives<T, dim> *collectives, sycl::queue &q) {
+        sycl::free(collectives->barrier_, q);
+        sycl::free(collectives->slots_, q);
+        sycl::free(collectives->parity_, q);
+        sycl::free(collectives, q);
+    }
+
+    /**
+     * Reduces the values of all the work-items of the grid. Must be called by all the work-items.
+     */
+    template<typename func>
+    T reduce(const sycl::nd_item<dim> &item, const T &value, const func &op) {
+        const T *slots = publish(item, sycl::reduce_over_group(item.get_group(), value, op));
+        return combine(item, slots, group_count_, op);
+    }
+
+    /**
+     * Returns to all the work-items the value held by the first work-item of the group root_group.
+     */
+    T broadcast(const sycl::nd_item<dim> &item, const T &value, const size_t &root_group = 0) {
+        const T *slots = publish(item, value);
+        return slots[root_group];
+    }
+
+    /**
+     * Exclusive scan over all the work-items of the grid, ordered by group and then by local id.
+     */
+    template<typename func>
+    T exclusive_scan(const sycl::nd_item<dim> &item, const T &value, const func &op) {
+        const T local_scan = sycl::exclusive_scan_over_group(item.get_group(), value, op);
+        const T *slots = publish(item, sycl::reduce_over_group(item.get_group(), value, op));
+        return op(combine(item, slots, item.get_group_linear_id(), op), local_scan);
+    }
+};
+
+
+template<typename T, int dim, typename func>
+static inline T grid_reduce(const sycl::nd_item<dim> &item, nd_range_collectives<T, dim> *collectives, const T &value, const func &op) {
+    return collectives->reduce(item, value, op);
+}
+
+template<typename T, int dim>
+static inline T grid_broadcast(const sycl::nd_item<dim> &item, nd_range_collectives<T, dim> *collectives, const T &value, const size_t &root_group = 0) {
+    return collectives->broadcast(item, value, root_group);
+}
+
+template<typename T, int dim, typename func>
+static inline T grid_exclusive_scan(const sycl::nd_item<dim> &item, nd_range_collectives<T, dim> *collectives, const T &value, const func &op) {
+    return collectives->exclusive_scan(item, value, op);
+}
+
+
+/**
+ * Exponential backoff used by the spinning primitives to reduce the contention on the atomics.
+ */
+class exponential_backoff {
+private:
+    uint32_t delay_;
+    const uint32_t max_delay_;
+
+public:
+    explicit exponential_backoff(uint32_t min_delay = 32, uint32_t max_delay = 4096) : delay_(min_delay), max_delay_(max_delay) {}
+
+    void operator()() {
+        sycl::ext::nanosleep(delay_);
+        delay_ = sycl::min(2 * delay_, max_delay_);
+    }
+};
+
+
+/**
+ * Mutex in global memory. On devices without independent forward progress for the work-items of a sub-group, lock()
+ * must only be called by one work-item of the sub-group, use group_lock instead.
+ */
+class device_mutex {
+private:
+    using atomic_ref_t = sycl::atomic_ref<
+            uint32_t,
+            sycl::memory_order::relaxed,
+            sycl::memory_scope::device,
+            sycl::access::address_space::global_space
+    >;
+
+    uint32_t locked_ = 0;
+
+public:
+    bool try_lock() {
+        atomic_ref_t locked_ref(locked_);
+        uint32_t expected = 0;
+        return locked_ref.load() == 0 && locked_ref.compare_exchange_strong(expected, 1, sycl::memory_order::acquire, sycl::memory_order::relaxed);
+    }
+
+    void lock() {
+        exponential_backoff backoff;
+        while (!try_lock()) {
+            backoff();
+        }
+    }
+
+    void unlock() {
+        atomic_ref_t locked_ref(locked_);
+        locked_ref.store(0, sycl::memory_order::release);
+    }
+};
+
+
+/**
+ * Counting semaphore in global memory, same restrictions as device_mutex.
+ */
+class device_semaphore {
+private:
+    using atomic_ref_t = sycl::atomic_ref<
+            int32_t,
+            sycl::memory_order::relaxed,
+            sycl::memory_scope::device,
+            sycl::access::address_space::global_space
+    >;
 
-            /* This group leaves the barrier. */
-            groups_waiting_ref.fetch_and(~this_group_mask);
+    int32_t count_;
 
-            if (groups_waiting_ref.load() == 0) {
-                barrier_reached_ref.store(0);
-            } else {
-                while (barrier_reached_ref.load() != 0) {}
+public:
+    explicit device_semaphore(int32_t count) : count_(count) {}
+
+    bool try_acquire() {
+        atomic_ref_t count_ref(count_);
+        int32_t count = count_ref.load();
+        while (count > 0) {
+            if (count_ref.compare_exchange_weak(count, count - 1, sycl::memory_order::acquire, sycl::memory_order::relaxed)) {
+                return true;
             }
         }
+        return false;
+    }
+
+    void acquire() {
+        exponential_backoff backoff;
+        while (!try_acquire()) {
+            backoff();
+        }
+    }
+
+    void release(int32_t update = 1) {
+        atomic_ref_t count_ref(count_);
+        count_ref.fetch_add(update, sycl::memory_order::release);
+    }
+};
+
+
+/**
+ * Fair lock, the work-items get the lock in the order they asked for it. Same restrictions as device_mutex.
+ */
+class ticket_lock {
+private:
+    using atomic_ref_t = sycl::atomic_ref<
+            uint32_t,
+            sycl::memory_order::relaxed,
+            sycl::memory_scope::device,
+            sycl::access::address_space::global_space
+    >;
+
+    uint32_t next_ticket_ = 0;
+    uint32_t now_serving_ = 0;
+
+public:
+    bool try_lock() {
+        atomic_ref_t next_ticket_ref(next_ticket_);
+        atomic_ref_t now_serving_ref(now_serving_);
+        uint32_t ticket = now_serving_ref.load();
+        return next_ticket_ref.compare_exchange_strong(ticket, ticket + 1, sycl::memory_order::acquire, sycl::memory_order::relaxed);
+    }
+
+    void lock() {
+        atomic_ref_t next_ticket_ref(next_ticket_);
+        atomic_ref_t now_serving_ref(now_serving_);
+        const uint32_t ticket = next_ticket_ref.fetch_add(1);
+        for (uint32_t serving = now_serving_ref.load(sycl::memory_order::acquire); serving != ticket; serving = now_serving_ref.load(sycl::memory_order::acquire)) {
+            sycl::ext::nanosleep(64 * (ticket - serving)); // Proportional backoff, the work-items ahead need that time
+        }
+    }
 
-        this_item.barrier(sycl::access::fence_space::local_space);
+    void unlock() {
+        atomic_ref_t now_serving_ref(now_serving_);
+        now_serving_ref.store(now_serving_ref.load() + 1, sycl::memory_order::release); // Only the owner writes it
     }
 };
 
 
+/**
+ * Locks from the leader of the group. The other work-items wait at a group barrier instead of spinning.
+ * Must be called by all the work-items of the group.
+ */
+template<int dim, typename lockable>
+static inline void group_lock(const sycl::nd_item<dim> &item, lockable &lock) {
+    if (item.get_local_linear_id() == 0) {
+        lock.lock();
+    }
+    item.barrier(sycl::access::fence_space::global_and_local);
+}
+
+template<int dim, typename lockable>
+static inline void group_unlock(const sycl::nd_item<dim> &item, lockable &lock) {
+    item.barrier(sycl::access::fence_space::global_and_local); // The whole group left the critical section
+    if (item.get_local_linear_id() == 0) {
+        lock.unlock();
+    }
+}
+
+template<int dim>
+static inline void group_acquire(const sycl::nd_item<dim> &item, device_semaphore &semaphore) {
+    if (item.get_local_linear_id() == 0) {
+        semaphore.acquire();
+    }
+    item.barrier(sycl::access::fence_space::global_and_local);
+}
+
+template<int dim>
+static inline void group_release(const sycl::nd_item<dim> &item, device_semaphore &semaphore, int32_t update = 1) {
+    item.barrier(sycl::access::fence_space::global_and_local);
+    if (item.get_local_linear_id() == 0) {
+        semaphore.release(update);
+    }
+}
+
+
+/**
+ * Per compute unit resources, they cannot be queried through SYCL. The defaults are the ones of the NVIDIA GPUs since Volta
+ * and are only applied to the CUDA back-end.
+ */
+struct compute_unit_limits {
+    size_t max_items = 2048;
+    size_t max_groups = 32;
+    size_t registers = 65536;
+};
+
+/**
+ * Resources used by a kernel
+ */
+struct kernel_resources {
+    size_t max_local_size = 1;
+    size_t local_mem_per_group = 0; // in bytes
+    size_t local_mem_per_item = 0; // in bytes
+    size_t registers_per_item = 0; // 0 if unknown
+    size_t sub_group_size = 1;
+};
+
+struct occupancy {
+    size_t groups_per_compute_unit = 1;
+    size_t local_size = 1;
+    size_t compute_units = 1;
+
+    [[nodiscard]] size_t resident_groups() const {
+        return groups_per_compute_unit * compute_units;
+    }
+
+    /**
+     * Largest grid that is guaranteed to be resident, usable by cooperative kernels.
+     * @param max_groups upper bound on the number of groups returned, pass nd_range_barrier<1>::max_group_count for grids
+     * synchronised with an nd_range_barrier
+     */
+    [[nodiscard]] sycl::nd_range<1> get_nd_range(size_t max_groups = std::numeric_limits<size_t>::max()) const {
+        const size_t group_count = std::max(size_t(1), std::min(max_groups, resident_groups()));
+        return {sycl::range<1>(group_count * local_size), sycl::range<1>(local_size)};
+    }
+};
+
+static inline bool is_cuda_device(const sycl::device &dev) {
+#if defined(SYCL_IMPLEMENTATION_HIPSYCL)
+    return dev.get_backend() == sycl::backend::cuda;
+#elif defined(SYCL_EXT_ONEAPI_BACKEND_CUDA)
+    return dev.get_backend() == sycl::backend::ext_oneapi_cuda;
+#else
+    (void) dev;
+    return false;
+#endif
+}
+
+/**
+ * Computes how many groups of a kernel can be co-resident on a compute unit, for every local size multiple of the sub-group
+ * size. The local size that maximises the number of resident work-items is kept, the largest one in case of tie.
+ * @param limits per compute unit limits of the device. When not given, the NVIDIA ones are used on the CUDA back-end and
+ * other devices get one group per compute unit, as their residency rules are unknown.
+ */
+static inline occupancy compute_occupancy(const sycl::device &dev, const kernel_resources &kernel, const std::optional<compute_unit_limits> &device_limits = std::nullopt) {
+    const size_t compute_units = dev.get_info<sycl::info::device::max_compute_units>();
+    const size_t local_mem_size = dev.get_info<sycl::info::device::local_mem_size>();
+    const size_t kernel_max_local_size = std::max(size_t(1), kernel.max_local_size);
+    const size_t sub_group_size = std::clamp(kernel.sub_group_size, size_t(1), kernel_max_local_size);
+    const size_t max_local_size = kernel_max_local_size - kernel_max_local_size % sub_group_size;
+
+    occupancy best{1, max_local_size, compute_units};
+    if (!dev.is_gpu()) { // Work-groups are not interleaved on CPU threads, only one can make progress at a time.
+        return best;
+    }
+    if (!device_limits && !is_cuda_device(dev)) {
+        return best;
+    }
+    const compute_unit_limits limits = device_limits.value_or(compute_unit_limits{});
+
+    size_t best_resident_items = 0;
+    for (size_t local_size = sub_group_size; local_size <= max_local_size; local_size += sub_group_size) {
+        size_t groups = std::min(limits.max_groups, limits.max_items / local_size);
+        const size_t group_local_mem = kernel.local_mem_per_group + kernel.local_mem_per_item * local_size;
+        if (group_local_mem > 0) {
+            groups = std::min(groups, local_mem_size / group_local_mem);
+        }
+        if (kernel.registers_per_item > 0) {
+            groups = std::min(groups, limits.registers / (kernel.registers_per_item * local_size));
+        }
+        if (groups > 0 && groups * local_size >= best_resident_items) {
+            best_resident_items = groups * local_size;
+            best.groups_per_compute_unit = groups;
+            best.local_size = local_size;
+        }
+    }
+    return best;
+}
+
+
+/**
+ * Queries the resources used by a kernel and computes its occupancy.
+ * @param local_mem_per_group local memory allocated by the kernel for each group, in bytes
+ * @param local_mem_per_item local memory allocated by the kernel for each work-item, in bytes
+ */
 template<typename KernelName>
-sycl::nd_range<1> get_max_occupancy(sycl::queue &q, size_t local_mem = 0) {
-    (void) local_mem;
+occupancy get_occupancy(sycl::queue &q, size_t local_mem_per_group = 0, size_t local_mem_per_item = 0, const std::optional<compute_unit_limits> &limits = std::nullopt) {
+    kernel_resources resources{};
+    resources.local_mem_per_group = local_mem_per_group;
+    resources.local_mem_per_item = local_mem_per_item;
 #ifndef SYCL_IMPLEMENTATION_HIPSYCL
     sycl::kernel_id id = sycl::get_kernel_id<KernelName>();
     auto kernel = sycl::get_kernel_bundle<sycl::bundle_state::executable>(q.get_context()).get_kernel(id);
-    size_t register_count = kernel.get_info<sycl::info::kernel_device_specific::ext_codeplay_num_regs>(q.get_device());
-    // size_t registers = private_mem_size / 2; // find a way to get that value
-    // printf("Kernel private mem size: %lu", private_mem_size);
-
-    size_t max_items = kernel.get_info<sycl::info::kernel_device_specific::work_group_size>(q.get_device());
+    resources.max_local_size = kernel.get_info<sycl::info::kernel_device_specific::work_group_size>(q.get_device());
+    resources.sub_group_size = kernel.get_info<sycl::info::kernel_device_specific::max_sub_group_size>(q.get_device());
+    try {
+        resources.registers_per_item = kernel.get_info<sycl::info::kernel_device_specific::ext_codeplay_num_regs>(q.get_device());
+    } catch (...) {
+        resources.registers_per_item = 0; // Only available on the CUDA back-end
+    }
 #else
-    size_t max_items = (uint32_t) q.get_device().get_info<sycl::info::device::max_work_group_size>();
+    resources.max_local_size = (uint32_t) q.get_device().get_info<sycl::info::device::max_work_group_size>();
 #endif
-    size_t max_groups = (uint32_t) q.get_device().get_info<sycl::info::device::max_compute_units>();
+    return compute_occupancy(q.get_device(), resources, limits);
+}
 
-    return {sycl::range<1>(max_items * max_groups), sycl::range<1>(max_items)};
+
+/**
+ * Returns the largest grid that is guaranteed to be resident on the device.
+ * @param local_mem local memory allocated by the kernel for each group, in bytes
+ */
+template<typename KernelName>
+sycl::nd_range<1> get_max_occupancy(sycl::queue &q, size_t local_mem = 0) {
+    return get_occupancy<KernelName>(q, local_mem).get_nd_range();
 }
 
 
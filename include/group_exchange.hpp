@@ -0,0 +1,111 @@
+/**
+    Copyright 2021 Codeplay Software Ltd.
+
+    Licensed under the Apache License, Version 2.0 (the "License");
+    you may not use these files except in compliance with the License.
+    You may obtain a copy of the License at
+
+    http://www.apache.org/licenses/LICENSE-2.0
+
+    For your convenience, a copy of the License has been included in this
+    repository.
+
+    Unless required by applicable law or agreed to in writing, software
+    distributed under the License is distributed on an "AS IS" BASIS,
+    WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+    See the License for the specific language governing permissions and
+    limitations under the License.
+ */
+
+#pragma once
+
+#include <sycl/sycl.hpp>
+#include <array>
+#include <local_mem_alignement_checker.hpp>
+
+/**
+ * Register exchanges between the two layouts of K elements per work-item over a group of size G:
+ *  - blocked: the work-item i owns the elements [i * K, (i + 1) * K), what register-blocked algorithms work on;
+ *  - striped: the work-item i owns the elements i, i + G, ..., i + (K - 1) * G, what coalesced memory accesses use.
+ */
+namespace sycl::ext {
+
+    enum class exchange_direction {
+        blocked_to_striped,
+        striped_to_blocked
+    };
+
+    /**
+     * Exchanges the items across the sub-group with shuffles only, no local memory is needed.
+     * Costs K * K shuffles, meant for small K. Must be called by the whole sub-group.
+     */
+    template<exchange_direction direction, typename T, size_t K>
+    static inline void sub_group_exchange(const sycl::sub_group &sg, std::array<T, K> &items) {
+        const size_t sg_size = sg.get_local_range().size();
+        const size_t lane = sg.get_local_linear_id();
+        std::array<T, K> out = items;
+#pragma unroll
+        for (size_t i = 0; i < K; ++i) {
+            // Position of the element the output register i holds, in the source layout
+            size_t src_lane, src_register;
+            if constexpr (direction == exchange_direction::blocked_to_striped) {
+                src_lane = (i * sg_size + lane) / K;
+                src_register = (i * sg_size + lane) % K;
+            } else {
+                src_lane = (lane * K + i) % sg_size;
+                src_register = (lane * K + i) / sg_size;
+            }
+#pragma unroll
+            for (size_t j = 0; j < K; ++j) { // Shuffles only use compile-time register indices
+                const T value = sycl::select_from_group(sg, items[j], src_lane);
+                if (src_register == j) out[i] = value;
+            }
+        }
+        items = out;
+    }
+
+    /**
+     * Number of elements of local memory needed by group_exchange.
+     */
+    template<typename T, size_t K, bool padded = true, int bank_count = 32>
+    static inline constexpr size_t group_exchange_local_size(const size_t &group_size) {
+        const size_t size = group_size * K;
+        return padded ? size + size / bank_count : size;
+    }
+
+    namespace internal {
+        template<bool padded, int bank_count = 32>
+        static inline constexpr size_t exchange_padded_index(const size_t &idx) {
+            return padded ? idx + idx / bank_count : idx; // One spare element every bank_count, the blocked strides spread over the banks
+        }
+    }
+
+    /**
+     * Exchanges the items across the work-group through local_mem, which must hold group_exchange_local_size elements.
+     * With padding the blocked accesses are free of bank conflicts, which requires sizeof(T) / 4 to be coprime with the bank
+     * count (checked by assert_local_alignement). Types like double must use padded = false.
+     * Must be called by the whole work-group, local_mem can be reused right after.
+     */
+    template<exchange_direction direction, bool padded = true, typename T, size_t K, int dim>
+    static inline void group_exchange(const sycl::nd_item<dim> &item, T *local_mem, std::array<T, K> &items) {
+        if constexpr (padded && sizeof(T) >= 4) {
+            assert_local_alignement<T>();
+        }
+        const size_t group_size = item.get_local_range().size();
+        const size_t id = item.get_local_linear_id();
+        auto blocked_index = [&](size_t i) { return internal::exchange_padded_index<padded>(id * K + i); };
+        auto striped_index = [&](size_t i) { return internal::exchange_padded_index<padded>(i * group_size + id); };
+
+        sycl::group_barrier(item.get_group()); // A previous use of local_mem may still be reading
+#pragma unroll
+        for (size_t i = 0; i < K; ++i) {
+            local_mem[direction == exchange_direction::blocked_to_striped ? blocked_index(i) : striped_index(i)] = items[i];
+        }
+        sycl::group_barrier(item.get_group());
+#pragma unroll
+        for (size_t i = 0; i < K; ++i) {
+            items[i] = local_mem[direction == exchange_direction::blocked_to_striped ? striped_index(i) : blocked_index(i)];
+        }
+    }
+
+}
@@ -0,0 +1,173 @@
+/**
+    Copyright 2021 Codeplay Software Ltd.
+
+    Licensed under the Apache License, Version 2.0 (the "License");
+    you may not use these files except in compliance with the License.
+    You may obtain a copy of the License at
+
+    http://www.apache.org/licenses/LICENSE-2.0
+
+    For your convenience, a copy of the License has been included in this
+    repository.
+
+    Unless required by applicable law or agreed to in writing, software
+    distributed under the License is distributed on an "AS IS" BASIS,
+    WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+    See the License for the specific language governing permissions and
+    limitations under the License.
+ */
+
+#pragma once
+
+#include <sycl/sycl.hpp>
+#include <array>
+#include <intrinsics.hpp>
+#include <group_exchange.hpp>
+
+/**
+ * Work-group load and store of a tile of G * K elements, K per work-item, for a work-group of G work-items.
+ * The elements past length are not accessed: loads fill their registers with a default value, stores skip them.
+ * Must be called by the whole work-group with the same arguments.
+ */
+namespace sycl::ext {
+
+    enum class load_store_mode {
+        direct,     // Blocked registers, work-item i accesses [i * K, (i + 1) * K), not coalesced
+        striped,    // Striped registers, work-item i accesses i, i + G, ..., coalesced
+        vectorized, // Blocked registers accessed with sycl::vec, falls back to direct for partial or misaligned tiles
+        transpose   // Blocked registers accessed striped then exchanged through local memory (see group_exchange)
+    };
+
+    namespace internal {
+        template<typename T, size_t K>
+        static inline constexpr bool is_vectorizable() {
+            return std::is_arithmetic_v<T> && (K == 2 || K == 4 || K == 8 || K == 16);
+        }
+
+        template<typename T, size_t K>
+        static inline bool can_vectorize(const T *ptr, const size_t &tile_size, const size_t &length) {
+            return is_vectorizable<T, K>() && length >= tile_size && reinterpret_cast<uintptr_t>(ptr) % (sizeof(T) * K) == 0;
+        }
+
+        /**
+         * The transpose pads its local memory when the type allows it, see group_exchange
+         */
+        template<typename T>
+        static inline constexpr bool is_transpose_padded() {
+            return sizeof(T) < 4 || (sizeof(T) % 4 == 0 && gcd(sizeof(T) / 4, 32) == 1);
+        }
+
+        template<load_store_mode mode, size_t K>
+        static inline size_t tile_index(const size_t &id, const size_t &group_size, const size_t &k) {
+            if constexpr (mode == load_store_mode::striped || mode == load_store_mode::transpose) {
+                return k * group_size + id;
+            } else {
+                return id * K + k;
+            }
+        }
+    }
+
+    /**
+     * Number of local memory elements group_load and group_store need, only the transpose mode uses local memory.
+     */
+    template<typename T, size_t K, load_store_mode mode>
+    static inline constexpr size_t group_load_store_local_size(const size_t &group_size) {
+        return mode == load_store_mode::transpose ? group_exchange_local_size<T, K, internal::is_transpose_padded<T>()>(group_size) : 0;
+    }
+
+    /**
+     * Loads the tile starting at in. length is the number of valid elements from in, it may span more than the tile.
+     * @tparam prefetch_distance when non zero, prefetches the elements this work-item will load prefetch_distance tiles
+     * ahead, within length
+     * @tparam hint cache hint of the global memory loads, see load_hinted
+     * @param local_mem local memory of group_load_store_local_size elements, only used by the transpose mode
+     */
+    template<size_t K, load_store_mode mode = load_store_mode::striped, size_t prefetch_distance = 0, cache_hint hint = cache_hint::normal, typename T, int dim>
+    static inline void group_load(const sycl::nd_item<dim> &item, const T *in, const size_t &length, std::array<T, K> &items, const T &default_value = T{}, T *local_mem = nullptr) {
+        const size_t group_size = item.get_local_range().size();
+        const size_t id = item.get_local_linear_id();
+        const size_t tile_size = group_size * K;
+
+        if constexpr (mode == load_store_mode::vectorized && internal::is_vectorizable<T, K>()) {
+            if (internal::can_vectorize<T, K>(in, tile_size, length)) {
+                const sycl::vec<T, K> vec = load_hinted<hint>(reinterpret_cast<const sycl::vec<T, K> *>(in + id * K));
+#pragma unroll
+                for (size_t k = 0; k < K; ++k) {
+                    items[k] = vec[k];
+                }
+                if constexpr (prefetch_distance > 0) {
+                    const size_t idx = prefetch_distance * tile_size + id * K;
+                    if (idx < length) prefetch(in + idx);
+                }
+                return;
+            }
+        }
+
+        if (length >= tile_size) { // Full tile, no bound checks
+#pragma unroll
+            for (size_t k = 0; k < K; ++k) {
+                items[k] = load_hinted<hint>(in + internal::tile_index<mode, K>(id, group_size, k));
+            }
+        } else {
+#pragma unroll
+            for (size_t k = 0; k < K; ++k) {
+                const size_t idx = internal::tile_index<mode, K>(id, group_size, k);
+                items[k] = idx < length ? load_hinted<hint>(in + idx) : default_value;
+            }
+        }
+
+        if constexpr (prefetch_distance > 0) {
+#pragma unroll
+            for (size_t k = 0; k < K; ++k) {
+                const size_t idx = prefetch_distance * tile_size + internal::tile_index<mode, K>(id, group_size, k);
+                if (idx < length) prefetch(in + idx);
+            }
+        }
+
+        if constexpr (mode == load_store_mode::transpose) {
+            group_exchange<exchange_direction::striped_to_blocked, internal::is_transpose_padded<T>()>(item, local_mem, items);
+        }
+    }
+
+    /**
+     * Stores the tile starting at out, only the first length elements are written.
+     * @tparam hint cache hint of the global memory stores, see store_hinted
+     * @param local_mem local memory of group_load_store_local_size elements, only used by the transpose mode
+     */
+    template<size_t K, load_store_mode mode = load_store_mode::striped, cache_hint hint = cache_hint::normal, typename T, int dim>
+    static inline void group_store(const sycl::nd_item<dim> &item, T *out, const size_t &length, std::array<T, K> items, T *local_mem = nullptr) {
+        const size_t group_size = item.get_local_range().size();
+        const size_t id = item.get_local_linear_id();
+        const size_t tile_size = group_size * K;
+
+        if constexpr (mode == load_store_mode::vectorized && internal::is_vectorizable<T, K>()) {
+            if (internal::can_vectorize<T, K>(out, tile_size, length)) {
+                sycl::vec<T, K> vec;
+#pragma unroll
+                for (size_t k = 0; k < K; ++k) {
+                    vec[k] = items[k];
+                }
+                store_hinted<hint>(reinterpret_cast<sycl::vec<T, K> *>(out + id * K), vec);
+                return;
+            }
+        }
+
+        if constexpr (mode == load_store_mode::transpose) {
+            group_exchange<exchange_direction::blocked_to_striped, internal::is_transpose_padded<T>()>(item, local_mem, items);
+        }
+
+        if (length >= tile_size) {
+#pragma unroll
+            for (size_t k = 0; k < K; ++k) {
+                store_hinted<hint>(out + internal::tile_index<mode, K>(id, group_size, k), items[k]);
+            }
+        } else {
+#pragma unroll
+            for (size_t k = 0; k < K; ++k) {
+                const size_t idx = internal::tile_index<mode, K>(id, group_size, k);
+                if (idx < length) store_hinted<hint>(out + idx, items[k]);
+            }
+        }
+    }
+
+}
@@ -23,8 +23,9 @@
 
 namespace internal {
 
-    static inline bool is_in_mask(uint32_t mask, size_t idx) {
-        return ((1u << idx) & mask) == (1u << idx);
+    template<typename mask_t>
+    static inline bool is_in_mask(mask_t mask, size_t idx) {
+        return ((mask_t{1} << idx) & mask) == (mask_t{1} << idx);
     }
 
 }
@@ -34,6 +35,14 @@ namespace internal {
  * For inline PTX @see https://docs.nvidia.com/cuda/inline-ptx-assembly/index.html
  * For PTX ISA doc @see https://docs.nvidia.com/cuda/parallel-thread-execution/index.html#integer-arithmetic-instructions-dp4a
  */
+/**
+ * Largest sub-group size the masks returned by ballot, match_any and predicate_to_mask must cover. 64 covers AMD
+ * wavefronts and CPU devices, define it to 32 to get 32-bit masks when only targeting 32-wide sub-groups.
+ */
+#ifndef SYCL_EXT_MAX_SUB_GROUP_SIZE
+#define SYCL_EXT_MAX_SUB_GROUP_SIZE 64
+#endif
+
 namespace sycl::ext {
 
 #ifdef SYCL_IMPLEMENTATION_ONEAPI
@@ -47,36 +56,112 @@ namespace sycl::ext {
 
 
     /**
+     * Shift amount taken modulo 32.
      * @see https://docs.nvidia.com/cuda/cuda-math-api/group__CUDA__MATH__INTRINSIC__INT.html#group__CUDA__MATH__INTRINSIC__INT_1gf939c350eafa2f13d64e278549d3a8aa
      */
     static inline uint32_t funnelshift_l(uint32_t lo, uint32_t hi, uint32_t shift) {
-        if (shift == 0) return hi; // To avoid shifting by 32
-        return (hi << (uint) (shift % 31)) | (lo >> (uint) (32 - (shift % 31)));
+#if defined (__NVPTX__) && defined(__SYCL_DEVICE_ONLY__)
+        uint32_t out;
+        asm("shf.l.wrap.b32 %0, %1, %2, %3;" : "=r"(out) : "r"(lo), "r"(hi), "r"(shift));
+        return out;
+#else
+        shift &= 31u;
+        return (hi << shift) | ((lo >> 1u) >> (31u - shift)); // Two shifts to avoid shifting by 32 when shift == 0
+#endif
     }
 
     /**
+     * Shift amount taken modulo 32.
      * @see https://docs.nvidia.com/cuda/cuda-math-api/group__CUDA__MATH__INTRINSIC__INT.html#group__CUDA__MATH__INTRINSIC__INT_1g125eeef4993d16dc8d679b239460fc34
      */
     static inline uint32_t funnelshift_r(uint32_t lo, uint32_t hi, uint32_t shift) {
-        if (shift == 0) return lo; // To avoid shifting by 32
-        return (lo >> shift % 31) | (hi << (32 - (shift % 31)));
+#if defined (__NVPTX__) && defined(__SYCL_DEVICE_ONLY__)
+        uint32_t out;
+        asm("shf.r.wrap.b32 %0, %1, %2, %3;" : "=r"(out) : "r"(lo), "r"(hi), "r"(shift));
+        return out;
+#else
+        shift &= 31u;
+        return (lo >> shift) | ((hi << 1u) << (31u - shift));
+#endif
     }
 
+    /**
+     * 64-bit funnel shifts, the shift amount is taken modulo 64.
+     */
+    static inline uint64_t funnelshift_l64(uint64_t lo, uint64_t hi, uint32_t shift) {
+        shift &= 63u;
+        return (hi << shift) | ((lo >> 1u) >> (63u - shift));
+    }
+
+    static inline uint64_t funnelshift_r64(uint64_t lo, uint64_t hi, uint32_t shift) {
+        shift &= 63u;
+        return (lo >> shift) | ((hi << 1u) << (63u - shift));
+    }
 
     /**
-     * Prefetches the data to the L1 cache on the CUDA Back-end, else is a no-op.
+     * Rotations, the shift amount is taken modulo the word size.
+     */
+    static inline uint32_t rotl32(uint32_t x, uint32_t shift) {
+        return funnelshift_l(x, x, shift);
+    }
+
+    static inline uint32_t rotr32(uint32_t x, uint32_t shift) {
+        return funnelshift_r(x, x, shift);
+    }
+
+    static inline uint64_t rotl64(uint64_t x, uint32_t shift) {
+        return funnelshift_l64(x, x, shift);
+    }
+
+    static inline uint64_t rotr64(uint64_t x, uint32_t shift) {
+        return funnelshift_r64(x, x, shift);
+    }
+
+
+    /**
+     * Temporal locality of prefetched data, from none (read once, keep out of the caches) to high (keep in all the
+     * levels). Same meaning as the last argument of __builtin_prefetch.
+     */
+    enum class prefetch_locality {
+        none = 0,
+        low = 1,
+        moderate = 2,
+        high = 3
+    };
+
+    /**
+     * Prefetches the data for a read. On the CUDA Back-end moderate and high locality go to the L1 cache, low and none
+     * to the L2 cache. SPIR-V device code, which includes the OpenCL CPU and Level Zero devices, uses the OpenCL prefetch
+     * of the global memory and ignores the locality. Host code uses __builtin_prefetch. Else is a no-op.
+     * ptr must point to global memory (USM or a global accessor), never to private or local memory: SPIR-V casts it to
+     * the global address space. Prefetching never faults, but ptr should still point in the allocation: the CUDA prefetch
+     * of an invalid address is undefined.
      * @see https://docs.nvidia.com/cuda/parallel-thread-execution/index.html#data-movement-and-conversion-instructions-prefetch-prefetchu
+     * @tparam locality temporal locality hint
      * @tparam T pointed type
      * @param ptr address to prefetch
      */
-    template<typename T>
+    template<prefetch_locality locality = prefetch_locality::high, typename T>
     void static inline prefetch(const T *ptr) {
 #if defined (__NVPTX__) && defined(__SYCL_DEVICE_ONLY__)
-        if constexpr (sizeof(ptr) == 8) {
-            asm("prefetch.L1 [%0];" :  : "l"(ptr));
+        if constexpr (locality == prefetch_locality::high || locality == prefetch_locality::moderate) {
+            if constexpr (sizeof(ptr) == 8) {
+                asm("prefetch.L1 [%0];" :  : "l"(ptr));
+            } else {
+                asm("prefetch.L1 [%0];" :  : "r"(ptr));
+            }
         } else {
-            asm("prefetch.L1 [%0];" :  : "r"(ptr));
+            if constexpr (sizeof(ptr) == 8) {
+                asm("prefetch.L2 [%0];" :  : "l"(ptr));
+            } else {
+                asm("prefetch.L2 [%0];" :  : "r"(ptr));
+            }
         }
+#elif defined(__SPIR__) && defined(__SYCL_DEVICE_ONLY__)
+        (void) locality;
+        __spirv_ocl_prefetch((const __attribute__((opencl_global)) char *) ptr, sizeof(T));
+#elif !defined(__SYCL_DEVICE_ONLY__) && __has_builtin(__builtin_prefetch)
+        __builtin_prefetch((const void *) ptr, 0, static_cast<int>(locality));
 #else
         (void) ptr;
 #endif
@@ -96,38 +181,228 @@ namespace sycl::ext {
     }
 
 
+    /**
+     * Cache behaviour of load_hinted and store_hinted:
+     *  - normal: regular cached access;
+     *  - streaming: the data is accessed once, evict it first (ld/st.global.cs on CUDA, non-temporal on CPU devices);
+     *  - readonly: the data is not written during the kernel, use the non-coherent read-only path (ld.global.nc on CUDA).
+     */
+    enum class cache_hint {
+        normal,
+        streaming,
+        readonly
+    };
+
+    namespace internal {
+        template<typename T>
+        static inline constexpr bool is_hintable() {
+            // The vector accesses need the natural alignment of their size, std::pair<int, int> is only 4 bytes aligned
+            return std::is_trivially_copyable_v<T> && (sizeof(T) == 4 || sizeof(T) == 8 || sizeof(T) == 16) && alignof(T) >= sizeof(T);
+        }
+    }
+
+    /**
+     * Loads *ptr with a cache hint. ptr must point to global memory for the hints to apply, types of other sizes than
+     * 4, 8 or 16 bytes, or less aligned than their size, use a regular load.
+     * @see https://docs.nvidia.com/cuda/parallel-thread-execution/index.html#cache-operators
+     */
+    template<cache_hint hint, typename T>
+    static inline T load_hinted(const T *ptr) {
+#if defined (__NVPTX__) && defined(__SYCL_DEVICE_ONLY__)
+        if constexpr (hint != cache_hint::normal && internal::is_hintable<T>()) {
+            if constexpr (sizeof(T) == 4) {
+                uint32_t out;
+                if constexpr (hint == cache_hint::streaming) {
+                    asm volatile("ld.global.cs.u32 %0, [%1];" : "=r"(out) : "l"(ptr));
+                } else {
+                    asm("ld.global.nc.u32 %0, [%1];" : "=r"(out) : "l"(ptr));
+                }
+                return sycl::bit_cast<T>(out);
+            } else if constexpr (sizeof(T) == 8) {
+                uint64_t out;
+                if constexpr (hint == cache_hint::streaming) {
+                    asm volatile("ld.global.cs.u64 %0, [%1];" : "=l"(out) : "l"(ptr));
+                } else {
+                    asm("ld.global.nc.u64 %0, [%1];" : "=l"(out) : "l"(ptr));
+                }
+                return sycl::bit_cast<T>(out);
+            } else {
+                sycl::vec<uint64_t, 2> out;
+                if constexpr (hint == cache_hint::streaming) {
+                    asm volatile("ld.global.cs.v2.u64 {%0, %1}, [%2];" : "=l"(out[0]), "=l"(out[1]) : "l"(ptr));
+                } else {
+                    asm("ld.global.nc.v2.u64 {%0, %1}, [%2];" : "=l"(out[0]), "=l"(out[1]) : "l"(ptr));
+                }
+                return sycl::bit_cast<T>(out);
+            }
+        }
+#elif defined(__SYCL_DEVICE_ONLY__) && __has_builtin(__builtin_nontemporal_load)
+        if constexpr (hint == cache_hint::streaming && std::is_arithmetic_v<T>) {
+            return __builtin_nontemporal_load(ptr);
+        }
+#endif
+        return *ptr;
+    }
+
+    /**
+     * Stores value to *ptr with a cache hint, readonly is treated as normal. ptr must point to global memory for the
+     * hints to apply.
+     */
+    template<cache_hint hint, typename T>
+    static inline void store_hinted(T *ptr, const T &value) {
+#if defined (__NVPTX__) && defined(__SYCL_DEVICE_ONLY__)
+        if constexpr (hint == cache_hint::streaming && internal::is_hintable<T>()) {
+            if constexpr (sizeof(T) == 4) {
+                asm volatile("st.global.cs.u32 [%0], %1;" : : "l"(ptr), "r"(sycl::bit_cast<uint32_t>(value)) : "memory");
+            } else if constexpr (sizeof(T) == 8) {
+                asm volatile("st.global.cs.u64 [%0], %1;" : : "l"(ptr), "l"(sycl::bit_cast<uint64_t>(value)) : "memory");
+            } else {
+                const auto words = sycl::bit_cast<sycl::vec<uint64_t, 2>>(value);
+                asm volatile("st.global.cs.v2.u64 [%0], {%1, %2};" : : "l"(ptr), "l"(words[0]), "l"(words[1]) : "memory");
+            }
+            return;
+        }
+#elif defined(__SYCL_DEVICE_ONLY__) && __has_builtin(__builtin_nontemporal_store)
+        if constexpr (hint == cache_hint::streaming && std::is_arithmetic_v<T>) {
+            __builtin_nontemporal_store(value, ptr);
+            return;
+        }
+#endif
+        *ptr = value;
+    }
+
+    /**
+     * Load of data read once, evicted first from the caches.
+     */
+    template<typename T>
+    static inline T load_streaming(const T *ptr) {
+        return load_hinted<cache_hint::streaming>(ptr);
+    }
+
+    /**
+     * Load through the read-only data path, the data must not be written during the kernel.
+     */
+    template<typename T>
+    static inline T load_readonly(const T *ptr) {
+        return load_hinted<cache_hint::readonly>(ptr);
+    }
+
+    /**
+     * Store of data that will not be read again by this kernel, evicted first from the caches.
+     */
+    template<typename T>
+    static inline void store_streaming(T *ptr, const T &value) {
+        store_hinted<cache_hint::streaming>(ptr, value);
+    }
+
+
+    /**
+     * Suspends the work-item for approximately ns nanoseconds on the CUDA Back-end (sm_70+), else busy-waits.
+     * @see https://docs.nvidia.com/cuda/parallel-thread-execution/index.html#miscellaneous-instructions-nanosleep
+     */
+    static inline void nanosleep(uint32_t ns) {
+#if defined (__NVPTX__) && defined(__SYCL_DEVICE_ONLY__) && defined(__SYCL_CUDA_ARCH__) && __SYCL_CUDA_ARCH__ >= 700
+        asm volatile("nanosleep.u32 %0;" :  : "r"(ns));
+#else
+        for (volatile uint32_t i = 0; i < ns; i = i + 1) {}
+#endif
+    }
+
+
     /**
      * Bit reversal
      */
     static inline uint32_t brev32(uint32_t num) {
-        auto reverse_num = uint32_t(0);
 #if defined (__NVPTX__) && defined(__SYCL_DEVICE_ONLY__)
+        auto reverse_num = uint32_t(0);
         asm("brev.b32 %0, %1;" : "=r"(reverse_num) : "r"(num));
+        return reverse_num;
+#elif __has_builtin(__builtin_bitreverse32)
+        return __builtin_bitreverse32(num);
 #else
-        const int size = sizeof(uint32_t) * 8;
-        for (int i = 0; i < size; i++) {
-            reverse_num |= uint32_t((num & (uint32_t(1) << i)) != 0) << ((size - 1) - i);
-        }
+        num = ((num >> 1u) & 0x55555555u) | ((num & 0x55555555u) << 1u);
+        num = ((num >> 2u) & 0x33333333u) | ((num & 0x33333333u) << 2u);
+        num = ((num >> 4u) & 0x0F0F0F0Fu) | ((num & 0x0F0F0F0Fu) << 4u);
+        return __builtin_bswap32(num);
 #endif
-        return reverse_num;
     }
 
     /**
      * Bit reversal
      */
     static inline uint64_t brev64(uint64_t num) {
-        auto reverse_num = uint64_t(0);
 #if defined (__NVPTX__) && defined(__SYCL_DEVICE_ONLY__)
+        auto reverse_num = uint64_t(0);
         asm("brev.b64 %0, %1;" : "=l"(reverse_num) : "l"(num));
+        return reverse_num;
+#elif __has_builtin(__builtin_bitreverse64)
+        return __builtin_bitreverse64(num);
 #else
-        const int size = sizeof(uint64_t) * 8;
-        for (int i = 0; i < size; i++) {
-            reverse_num |= uint64_t((num & (uint64_t(1) << i)) != 0) << ((size - 1) - i);
-        }
+        num = ((num >> 1u) & 0x5555555555555555ul) | ((num & 0x5555555555555555ul) << 1u);
+        num = ((num >> 2u) & 0x3333333333333333ul) | ((num & 0x3333333333333333ul) << 2u);
+        num = ((num >> 4u) & 0x0F0F0F0F0F0F0F0Ful) | ((num & 0x0F0F0F0F0F0F0F0Ful) << 4u);
+        return __builtin_bswap64(num);
 #endif
-        return reverse_num;
     }
 
+    /**
+     * Count of leading zeros, returns the word size for 0.
+     * The builtins are lowered to the native instructions on every back-end (clz, lzcnt, OpExtInst clz).
+     */
+    static inline constexpr uint32_t clz32(uint32_t x) {
+        return x == 0 ? 32u : (uint32_t) __builtin_clz(x);
+    }
+
+    static inline constexpr uint32_t clz64(uint64_t x) {
+        return x == 0 ? 64u : (uint32_t) __builtin_clzll(x);
+    }
+
+    /**
+     * Count of trailing zeros, returns the word size for 0.
+     */
+    static inline constexpr uint32_t ctz32(uint32_t x) {
+        return x == 0 ? 32u : (uint32_t) __builtin_ctz(x);
+    }
+
+    static inline constexpr uint32_t ctz64(uint64_t x) {
+        return x == 0 ? 64u : (uint32_t) __builtin_ctzll(x);
+    }
+
+    /**
+     * Population count
+     */
+    static inline constexpr uint32_t popc32(uint32_t x) {
+        return (uint32_t) __builtin_popcount(x);
+    }
+
+    static inline constexpr uint32_t popc64(uint64_t x) {
+        return (uint32_t) __builtin_popcountll(x);
+    }
+
+    /**
+     * Position (starting at 1) of the least significant bit set, 0 if x == 0.
+     */
+    static inline constexpr uint32_t ffs32(uint32_t x) {
+        return (uint32_t) __builtin_ffs((int) x);
+    }
+
+    static inline constexpr uint32_t ffs64(uint64_t x) {
+        return (uint32_t) __builtin_ffsll((long long) x);
+    }
+
+    /**
+     * Position of the most significant bit set, 0xFFFFFFFF if x == 0.
+     * @see https://docs.nvidia.com/cuda/parallel-thread-execution/index.html#integer-arithmetic-instructions-bfind
+     */
+    static inline constexpr uint32_t bfind32(uint32_t x) {
+        return 31u - clz32(x); // Wraps around to 0xFFFFFFFF for 0
+    }
+
+    static inline constexpr uint32_t bfind64(uint64_t x) {
+        return 63u - clz64(x);
+    }
+
+
 #ifdef SYCL_IMPLEMENTATION_HIPSYCL
     uint32_t upsample(const uint16_t &hi, const uint16_t &lo) {
         return (uint32_t(hi) << 16) + lo;
@@ -148,20 +423,360 @@ namespace sycl::ext {
     }
 
 
+    namespace internal {
+        /**
+         * Words smaller than 32 bits are processed as 32 bits words, keeping the signedness.
+         */
+        template<typename T>
+        using bitfield_word_t = std::conditional_t<(sizeof(T) <= sizeof(uint32_t)),
+                std::conditional_t<std::is_signed_v<T>, int32_t, uint32_t>,
+                std::conditional_t<std::is_signed_v<T>, int64_t, uint64_t>>;
+
+        template<typename T>
+        static inline constexpr T low_bit_mask(const uint &len) {
+            static_assert(std::is_unsigned_v<T>);
+            return len == 0 ? T{0} : T(~T{0}) >> (sizeof(T) * 8 - len);
+        }
+    }
+
+    /**
+     * Bitfield extract, returns the len bits of word starting at bit pos. Signed types are sign-extended from the bit pos + len - 1.
+     * pos must be less than the word size and len at most the word size.
+     * @see https://docs.nvidia.com/cuda/parallel-thread-execution/index.html#integer-arithmetic-instructions-bfe
+     */
+    template<typename T>
+    static inline constexpr T bfe(const T &word, const uint &pos, const uint &len) {
+        static_assert(std::is_integral_v<T> && sizeof(T) <= sizeof(uint64_t));
+        using word_t = internal::bitfield_word_t<T>;
+        using unsigned_word_t = std::make_unsigned_t<word_t>;
+        constexpr uint word_bits = sizeof(word_t) * 8;
+        assume(pos < word_bits && len <= word_bits);
+#if defined (__NVPTX__) && defined(__SYCL_DEVICE_ONLY__)
+        if (!__builtin_is_constant_evaluated()) {
+            word_t out;
+            if constexpr (std::is_same_v<word_t, uint32_t>) {
+                asm("bfe.u32 %0, %1, %2, %3;" : "=r"(out) : "r"(word_t(word)), "r"(pos), "r"(len));
+            } else if constexpr (std::is_same_v<word_t, int32_t>) {
+                asm("bfe.s32 %0, %1, %2, %3;" : "=r"(out) : "r"(word_t(word)), "r"(pos), "r"(len));
+            } else if constexpr (std::is_same_v<word_t, uint64_t>) {
+                asm("bfe.u64 %0, %1, %2, %3;" : "=l"(out) : "l"(word_t(word)), "r"(pos), "r"(len));
+            } else {
+                asm("bfe.s64 %0, %1, %2, %3;" : "=l"(out) : "l"(word_t(word)), "r"(pos), "r"(len));
+            }
+            return T(out);
+        }
+#endif
+        const unsigned_word_t field = (unsigned_word_t(word) >> pos) & internal::low_bit_mask<unsigned_word_t>(len);
+        if constexpr (std::is_signed_v<T>) {
+            if (len == 0) return T{0};
+            return T(word_t(field << (word_bits - len)) >> (word_bits - len)); // Arithmetic shift to sign-extend
+        } else {
+            return T(field);
+        }
+    }
+
+    /**
+     * Bitfield insert, returns base with its len bits starting at pos replaced by the low bits of insert.
+     * pos must be less than the word size and len at most the word size.
+     * @see https://docs.nvidia.com/cuda/parallel-thread-execution/index.html#integer-arithmetic-instructions-bfi
+     */
+    template<typename T>
+    static inline constexpr T bfi(const T &insert, const T &base, const uint &pos, const uint &len) {
+        static_assert(std::is_integral_v<T> && sizeof(T) <= sizeof(uint64_t));
+        using unsigned_word_t = std::make_unsigned_t<internal::bitfield_word_t<T>>;
+        assume(pos < sizeof(unsigned_word_t) * 8 && len <= sizeof(unsigned_word_t) * 8);
+#if defined (__NVPTX__) && defined(__SYCL_DEVICE_ONLY__)
+        if (!__builtin_is_constant_evaluated()) {
+            unsigned_word_t out;
+            if constexpr (sizeof(unsigned_word_t) == sizeof(uint32_t)) {
+                asm("bfi.b32 %0, %1, %2, %3, %4;" : "=r"(out) : "r"(unsigned_word_t(insert)), "r"(unsigned_word_t(base)), "r"(pos), "r"(len));
+            } else {
+                asm("bfi.b64 %0, %1, %2, %3, %4;" : "=l"(out) : "l"(unsigned_word_t(insert)), "l"(unsigned_word_t(base)), "r"(pos), "r"(len));
+            }
+            return T(out);
+        }
+#endif
+        const unsigned_word_t mask = internal::low_bit_mask<unsigned_word_t>(len) << pos;
+        return T((unsigned_word_t(base) & ~mask) | ((unsigned_word_t(insert) << pos) & mask));
+    }
+
+    /**
+     * Byte permutation, the byte n of the result is the byte of {y, x} selected by the nibble n of selector (only the
+     * 3 low bits of each nibble are used).
+     * @see https://docs.nvidia.com/cuda/parallel-thread-execution/index.html#data-movement-and-conversion-instructions-prmt
+     */
+    static inline constexpr uint32_t byte_perm(const uint32_t &x, const uint32_t &y, const uint32_t &selector) {
+#if defined (__NVPTX__) && defined(__SYCL_DEVICE_ONLY__)
+        if (!__builtin_is_constant_evaluated()) {
+            uint32_t out;
+            asm("prmt.b32 %0, %1, %2, %3;" : "=r"(out) : "r"(x), "r"(y), "r"(selector & 0x7777u));
+            return out;
+        }
+#endif
+        const uint64_t bytes = (uint64_t(y) << 32u) | x;
+        uint32_t out = 0;
+#pragma unroll
+        for (uint n = 0; n < 4; ++n) {
+            const uint byte_id = (selector >> (4 * n)) & 0x7u;
+            out |= uint32_t((bytes >> (8 * byte_id)) & 0xFFu) << (8 * n);
+        }
+        return out;
+    }
+
+    namespace internal {
+        /**
+         * SIMD within a register helpers, the uint32_t words hold 32 / lane_bits unsigned lanes.
+         * high_bits has the most significant bit of every lane set.
+         */
+        template<uint lane_bits>
+        static inline constexpr uint32_t swar_high_bits() {
+            static_assert(lane_bits == 8 || lane_bits == 16);
+            return lane_bits == 8 ? 0x80808080u : 0x80008000u;
+        }
+
+        template<uint lane_bits>
+        static inline constexpr uint32_t swar_add(const uint32_t &a, const uint32_t &b) {
+            constexpr uint32_t high = swar_high_bits<lane_bits>();
+            return ((a & ~high) + (b & ~high)) ^ ((a ^ b) & high); // Carries can't cross the lanes
+        }
+
+        template<uint lane_bits>
+        static inline constexpr uint32_t swar_sub(const uint32_t &a, const uint32_t &b) {
+            constexpr uint32_t high = swar_high_bits<lane_bits>();
+            return ((a | high) - (b & ~high)) ^ ((a ^ ~b) & high); // Borrows can't cross the lanes
+        }
+
+        /**
+         * Expands the most significant bit of each lane to the whole lane
+         */
+        template<uint lane_bits>
+        static inline constexpr uint32_t swar_lane_mask(const uint32_t &high_bits) {
+            return (high_bits >> (lane_bits - 1)) * ((1u << lane_bits) - 1u);
+        }
+
+        /**
+         * Lane mask of a >= b
+         */
+        template<uint lane_bits>
+        static inline constexpr uint32_t swar_cmpge(const uint32_t &a, const uint32_t &b) {
+            constexpr uint32_t high = swar_high_bits<lane_bits>();
+            const uint32_t low_ge = (a | high) - (b & ~high); // Lane sign bit set when the low bits of a are >= the ones of b
+            return swar_lane_mask<lane_bits>(((a & ~b) | (~(a ^ b) & low_ge)) & high);
+        }
+
+        template<uint lane_bits>
+        static inline constexpr uint32_t swar_cmpeq(const uint32_t &a, const uint32_t &b) {
+            constexpr uint32_t high = swar_high_bits<lane_bits>();
+            const uint32_t diff = a ^ b;
+            const uint32_t non_zero = (((diff & ~high) + ~high) | diff) & high;
+            return swar_lane_mask<lane_bits>(~non_zero & high);
+        }
+
+        template<uint lane_bits>
+        static inline constexpr uint32_t swar_max(const uint32_t &a, const uint32_t &b) {
+            const uint32_t ge = swar_cmpge<lane_bits>(a, b);
+            return (a & ge) | (b & ~ge);
+        }
+
+        template<uint lane_bits>
+        static inline constexpr uint32_t swar_absdiff(const uint32_t &a, const uint32_t &b) {
+            const uint32_t ge = swar_cmpge<lane_bits>(a, b);
+            return swar_sub<lane_bits>((a & ge) | (b & ~ge), (b & ge) | (a & ~ge));
+        }
+
+        template<uint lane_bits, typename T>
+        static inline constexpr int32_t swar_lane(const T &word, const uint &lane) {
+            if constexpr (std::is_signed_v<T>) {
+                return bfe(int32_t(word), lane * lane_bits, lane_bits);
+            } else {
+                return int32_t(bfe(uint32_t(word), lane * lane_bits, lane_bits));
+            }
+        }
+    }
+
+    /**
+     * Per-byte wrapping addition of 4 packed unsigned bytes.
+     * @see https://docs.nvidia.com/cuda/cuda-math-api/group__CUDA__MATH__INTRINSIC__SIMD.html
+     */
+    static inline constexpr uint32_t vadd4(const uint32_t &a, const uint32_t &b) {
+        return internal::swar_add<8>(a, b);
+    }
+
+    /**
+     * Per-halfword wrapping addition of 2 packed unsigned halfwords.
+     */
+    static inline constexpr uint32_t vadd2(const uint32_t &a, const uint32_t &b) {
+        return internal::swar_add<16>(a, b);
+    }
+
+    /**
+     * Per-byte wrapping subtraction of 4 packed unsigned bytes.
+     */
+    static inline constexpr uint32_t vsub4(const uint32_t &a, const uint32_t &b) {
+        return internal::swar_sub<8>(a, b);
+    }
+
+    /**
+     * Per-halfword wrapping subtraction of 2 packed unsigned halfwords.
+     */
+    static inline constexpr uint32_t vsub2(const uint32_t &a, const uint32_t &b) {
+        return internal::swar_sub<16>(a, b);
+    }
+
+    /**
+     * Per-byte |a - b| of 4 packed unsigned bytes.
+     * @see https://docs.nvidia.com/cuda/parallel-thread-execution/index.html#scalar-video-instructions
+     */
+    static inline constexpr uint32_t vabsdiff4(const uint32_t &a, const uint32_t &b) {
+#if defined (__NVPTX__) && defined(__SYCL_DEVICE_ONLY__)
+        if (!__builtin_is_constant_evaluated()) {
+            uint32_t out;
+            asm("vabsdiff4.u32.u32.u32 %0, %1, %2, %3;" : "=r"(out) : "r"(a), "r"(b), "r"(0u));
+            return out;
+        }
+#endif
+        return internal::swar_absdiff<8>(a, b);
+    }
+
+    /**
+     * Per-halfword |a - b| of 2 packed unsigned halfwords.
+     */
+    static inline constexpr uint32_t vabsdiff2(const uint32_t &a, const uint32_t &b) {
+#if defined (__NVPTX__) && defined(__SYCL_DEVICE_ONLY__)
+        if (!__builtin_is_constant_evaluated()) {
+            uint32_t out;
+            asm("vabsdiff2.u32.u32.u32 %0, %1, %2, %3;" : "=r"(out) : "r"(a), "r"(b), "r"(0u));
+            return out;
+        }
+#endif
+        return internal::swar_absdiff<16>(a, b);
+    }
+
+    /**
+     * Per-byte maximum of 4 packed unsigned bytes.
+     */
+    static inline constexpr uint32_t vmax4(const uint32_t &a, const uint32_t &b) {
+#if defined (__NVPTX__) && defined(__SYCL_DEVICE_ONLY__)
+        if (!__builtin_is_constant_evaluated()) {
+            uint32_t out;
+            asm("vmax4.u32.u32.u32 %0, %1, %2, %3;" : "=r"(out) : "r"(a), "r"(b), "r"(0u));
+            return out;
+        }
+#endif
+        return internal::swar_max<8>(a, b);
+    }
+
+    /**
+     * Per-halfword maximum of 2 packed unsigned halfwords.
+     */
+    static inline constexpr uint32_t vmax2(const uint32_t &a, const uint32_t &b) {
+#if defined (__NVPTX__) && defined(__SYCL_DEVICE_ONLY__)
+        if (!__builtin_is_constant_evaluated()) {
+            uint32_t out;
+            asm("vmax2.u32.u32.u32 %0, %1, %2, %3;" : "=r"(out) : "r"(a), "r"(b), "r"(0u));
+            return out;
+        }
+#endif
+        return internal::swar_max<16>(a, b);
+    }
+
+    /**
+     * Per-byte comparison of 4 packed bytes, each byte of the result is 0xFF if the bytes are equal, 0 otherwise.
+     */
+    static inline constexpr uint32_t vcmpeq4(const uint32_t &a, const uint32_t &b) {
+        return internal::swar_cmpeq<8>(a, b);
+    }
+
+    /**
+     * Per-halfword comparison of 2 packed halfwords, each halfword of the result is 0xFFFF if they are equal, 0 otherwise.
+     */
+    static inline constexpr uint32_t vcmpeq2(const uint32_t &a, const uint32_t &b) {
+        return internal::swar_cmpeq<16>(a, b);
+    }
+
+    /**
+     * Four-way byte dot product accumulate: c + sum(a.byte[i] * b.byte[i]). The bytes are signed for int32_t operands.
+     * Native on sm_61 and newer.
+     * @see https://docs.nvidia.com/cuda/parallel-thread-execution/index.html#integer-arithmetic-instructions-dp4a
+     */
+    template<typename T>
+    static inline constexpr T dp4a(const T &a, const T &b, const T &c) {
+        static_assert(std::is_same_v<T, uint32_t> || std::is_same_v<T, int32_t>);
+#if defined (__NVPTX__) && defined(__SYCL_DEVICE_ONLY__) && defined(__SYCL_CUDA_ARCH__) && __SYCL_CUDA_ARCH__ >= 610
+        if (!__builtin_is_constant_evaluated()) {
+            T out;
+            if constexpr (std::is_signed_v<T>) {
+                asm("dp4a.s32.s32 %0, %1, %2, %3;" : "=r"(out) : "r"(a), "r"(b), "r"(c));
+            } else {
+                asm("dp4a.u32.u32 %0, %1, %2, %3;" : "=r"(out) : "r"(a), "r"(b), "r"(c));
+            }
+            return out;
+        }
+#endif
+        T out = c;
+#pragma unroll
+        for (uint lane = 0; lane < 4; ++lane) {
+            out += T(internal::swar_lane<8>(a, lane) * internal::swar_lane<8>(b, lane));
+        }
+        return out;
+    }
+
+    /**
+     * Two-way dot product accumulate of the halfwords of a with the two low bytes of b: c + sum(a.half[i] * b.byte[i]).
+     * The lanes are signed for int32_t operands. Native on sm_61 and newer.
+     * @see https://docs.nvidia.com/cuda/parallel-thread-execution/index.html#integer-arithmetic-instructions-dp2a
+     */
+    template<typename T>
+    static inline constexpr T dp2a_lo(const T &a, const T &b, const T &c) {
+        static_assert(std::is_same_v<T, uint32_t> || std::is_same_v<T, int32_t>);
+#if defined (__NVPTX__) && defined(__SYCL_DEVICE_ONLY__) && defined(__SYCL_CUDA_ARCH__) && __SYCL_CUDA_ARCH__ >= 610
+        if (!__builtin_is_constant_evaluated()) {
+            T out;
+            if constexpr (std::is_signed_v<T>) {
+                asm("dp2a.lo.s32.s32 %0, %1, %2, %3;" : "=r"(out) : "r"(a), "r"(b), "r"(c));
+            } else {
+                asm("dp2a.lo.u32.u32 %0, %1, %2, %3;" : "=r"(out) : "r"(a), "r"(b), "r"(c));
+            }
+            return out;
+        }
+#endif
+        return c + T(internal::swar_lane<16>(a, 0) * internal::swar_lane<8>(b, 0) + internal::swar_lane<16>(a, 1) * internal::swar_lane<8>(b, 1));
+    }
+
+    /**
+     * Same as dp2a_lo using the two high bytes of b.
+     */
+    template<typename T>
+    static inline constexpr T dp2a_hi(const T &a, const T &b, const T &c) {
+        static_assert(std::is_same_v<T, uint32_t> || std::is_same_v<T, int32_t>);
+#if defined (__NVPTX__) && defined(__SYCL_DEVICE_ONLY__) && defined(__SYCL_CUDA_ARCH__) && __SYCL_CUDA_ARCH__ >= 610
+        if (!__builtin_is_constant_evaluated()) {
+            T out;
+            if constexpr (std::is_signed_v<T>) {
+                asm("dp2a.hi.s32.s32 %0, %1, %2, %3;" : "=r"(out) : "r"(a), "r"(b), "r"(c));
+            } else {
+                asm("dp2a.hi.u32.u32 %0, %1, %2, %3;" : "=r"(out) : "r"(a), "r"(b), "r"(c));
+            }
+            return out;
+        }
+#endif
+        return c + T(internal::swar_lane<16>(a, 0) * internal::swar_lane<8>(b, 2) + internal::swar_lane<16>(a, 1) * internal::swar_lane<8>(b, 3));
+    }
+
+
+
     template<typename T>
     static inline constexpr uint8_t get_byte(const T &word, const uint &position) {
         static_assert(std::is_integral_v<T> && std::is_unsigned_v<T> && sizeof(T) >= sizeof(uint8_t));
         assume(position < sizeof(T));
-        return (word >> (8 * position)) & 0xFF;
+        return uint8_t(bfe(word, 8 * position, 8));
     }
 
     template<typename T>
     static inline constexpr T set_byte(const T &word, const uint8_t &byte_in, const uint &position) {
         static_assert(std::is_integral_v<T> && std::is_unsigned_v<T> && sizeof(T) >= sizeof(uint8_t));
         assume(position < sizeof(T));
-        T select_mask = ~(T(0xFF) << (position * 8));
-        T new_val = (T(byte_in) & 0xFF) << (position * 8);
-        return (word & select_mask) + new_val;
+        return bfi(T(byte_in), word, 8 * position, 8);
     }
 
 
@@ -178,21 +793,15 @@ namespace sycl::ext {
 
     template<typename T>
     static inline constexpr T set_bit_in_word(const T &word, const uint &position, const bool bit) {
-        if (bit) {
-            return set_bit_in_word<true, T>(word, position);
-        } else {
-            return set_bit_in_word<false, T>(word, position);
-        }
+        static_assert(std::is_integral_v<T> && std::is_unsigned_v<T>);
+        return bfi(T(bit), word, position, 1);
     }
 
 
     template<typename T>
     static inline constexpr bool read_bit(const T &word, const uint &idx) {
         static_assert(std::is_integral_v<T> && std::is_unsigned_v<T>);
-        if (word == 0) {
-            return false;
-        }
-        return (word & (T{1} << idx)) != 0;
+        return bfe(word, idx, 1) != 0;
     }
 
     template<typename T>
@@ -201,42 +810,106 @@ namespace sycl::ext {
         return word ^ (T{1} << idx);
     }
 
-    template<typename func>
-    static inline uint32_t predicate_to_mask(const sycl::sub_group &sg, func &&predicate) {
+    /**
+     * Mask holding one bit per work-item of a sub-group of at most max_sub_group_size work-items.
+     */
+    template<size_t max_sub_group_size = SYCL_EXT_MAX_SUB_GROUP_SIZE>
+    using sub_group_mask_t = std::conditional_t<(max_sub_group_size <= 32), uint32_t, uint64_t>;
+
+    template<size_t max_sub_group_size = SYCL_EXT_MAX_SUB_GROUP_SIZE, typename func>
+    static inline sub_group_mask_t<max_sub_group_size> predicate_to_mask(const sycl::sub_group &sg, func &&predicate) {
+        static_assert(max_sub_group_size <= 64, "Sub-group masks are limited to 64 work-items");
+        using mask_t = sub_group_mask_t<max_sub_group_size>;
         uint32_t group_count = sg.get_local_range().size();
-        uint32_t out = 0;
+        mask_t out = 0;
         for (size_t gr = 0; gr < group_count; ++gr) {
-            out |= uint32_t(predicate(gr) ? 1 : 0) << gr;
+            out |= mask_t(predicate(gr) ? 1 : 0) << gr;
         }
         return out;
     }
 
 #ifndef SYCL_IMPLEMENTATION_HIPSYCL
-    static inline uint32_t ballot(const sycl::sub_group &sg, int predicate) {
-        uint32_t local_val = (predicate ? 1u : 0u) << (sg.get_local_linear_id());
-        return sycl::reduce_over_group(sg, local_val, sycl::plus<>());
+    /**
+     * Mask of the work-items of the sub-group where predicate is not 0. Uses the native vote on CUDA and the oneAPI
+     * group_ballot when available, otherwise a bitwise-or reduction.
+     */
+    template<size_t max_sub_group_size = SYCL_EXT_MAX_SUB_GROUP_SIZE>
+    static inline sub_group_mask_t<max_sub_group_size> ballot(const sycl::sub_group &sg, int predicate) {
+        static_assert(max_sub_group_size <= 64, "Sub-group masks are limited to 64 work-items");
+        using mask_t = sub_group_mask_t<max_sub_group_size>;
+#if defined (__NVPTX__) && defined(__SYCL_DEVICE_ONLY__)
+        uint32_t out;
+#if defined(__SYCL_CUDA_ARCH__) && __SYCL_CUDA_ARCH__ >= 700
+        const uint32_t local_range = sg.get_local_range().size();
+        const uint32_t member_mask = local_range >= 32 ? 0xFFFFFFFFu : (1u << local_range) - 1u;
+        asm volatile("{\n\t.reg .pred p;\n\tsetp.ne.s32 p, %1, 0;\n\tvote.sync.ballot.b32 %0, p, %2;\n\t}" : "=r"(out) : "r"(predicate), "r"(member_mask));
+#else
+        asm volatile("{\n\t.reg .pred p;\n\tsetp.ne.s32 p, %1, 0;\n\tvote.ballot.b32 %0, p;\n\t}" : "=r"(out) : "r"(predicate));
+#endif
+        return mask_t(out);
+#elif defined(SYCL_EXT_ONEAPI_SUB_GROUP_MASK)
+        mask_t out = 0;
+        sycl::ext::oneapi::group_ballot(sg, predicate != 0).extract_bits(out);
+        return out;
+#else
+        const mask_t local_val = mask_t(predicate ? 1u : 0u) << sg.get_local_linear_id();
+        return sycl::reduce_over_group(sg, local_val, sycl::bit_or<mask_t>());
+#endif
     }
 #endif
 
-    template<typename T>
-    static inline uint32_t match_any(const sycl::sub_group &sg, T val) {
-        size_t local_range = sg.get_local_range().size();
-        uint32_t found = 0;
+    /**
+     * Mask of the work-items of the sub-group holding the same value as this work-item. Uses match.any on sm_70 and
+     * newer for integral values, otherwise each round ballots the value of the first unmatched work-item and retires
+     * its whole class, so the cost scales with the number of distinct values instead of the sub-group size. A value that
+     * does not compare equal to itself (NaN) is alone in its class.
+     */
+    template<typename T, size_t max_sub_group_size = SYCL_EXT_MAX_SUB_GROUP_SIZE>
+    static inline sub_group_mask_t<max_sub_group_size> match_any(const sycl::sub_group &sg, T val) {
+        using mask_t = sub_group_mask_t<max_sub_group_size>;
+        const uint32_t local_range = sg.get_local_range().size();
+#if defined (__NVPTX__) && defined(__SYCL_DEVICE_ONLY__) && defined(__SYCL_CUDA_ARCH__) && __SYCL_CUDA_ARCH__ >= 700
+        if constexpr (std::is_integral_v<T> && sizeof(T) <= sizeof(uint64_t)) {
+            const uint32_t member_mask = local_range >= 32 ? 0xFFFFFFFFu : (1u << local_range) - 1u;
+            uint32_t out;
+            if constexpr (sizeof(T) <= sizeof(uint32_t)) {
+                asm volatile("match.any.sync.b32 %0, %1, %2;" : "=r"(out) : "r"(uint32_t(val)), "r"(member_mask));
+            } else {
+                asm volatile("match.any.sync.b64 %0, %1, %2;" : "=r"(out) : "l"(uint64_t(val)), "r"(member_mask));
+            }
+            return mask_t(out);
+        }
+#endif
+#ifndef SYCL_IMPLEMENTATION_HIPSYCL
+        mask_t remaining = local_range >= sizeof(mask_t) * 8 ? ~mask_t{0} : (mask_t{1} << local_range) - 1u;
+        const uint32_t lane = sg.get_local_linear_id();
+        mask_t found = 0;
+        while (remaining != 0) { // Uniform across the sub-group
+            const uint32_t leader = ctz64(remaining);
+            const T leader_val = sycl::select_from_group(sg, val, leader);
+            const mask_t same = ballot<max_sub_group_size>(sg, leader_val == val) | (mask_t{1} << leader); // The leader is retired even if its value is NaN
+            if (leader_val == val || lane == leader) found = same;
+            remaining &= ~same;
+        }
+        return found;
+#else
+        mask_t found = mask_t{1} << sg.get_local_linear_id();
         for (uint32_t i = 0; i < local_range; ++i) {
             const T from_other = sycl::select_from_group(sg, val, i);
-            found |= (from_other == val ? 1u : 0u) << i;
+            found |= mask_t(from_other == val ? 1u : 0u) << i;
         }
         return found;
+#endif
     }
 
 #ifndef SYCL_IMPLEMENTATION_HIPSYCL
-    template<typename T>
-    static inline bool match_all(const sycl::sub_group &sg, uint32_t mask, T val) {
+    template<typename T, size_t max_sub_group_size = SYCL_EXT_MAX_SUB_GROUP_SIZE>
+    static inline bool match_all(const sycl::sub_group &sg, sub_group_mask_t<max_sub_group_size> mask, T val) {
         if (mask == 0) return false;
-        size_t first_work_item_id = sycl::ext::intel::ctz(mask);
-        if (first_work_item_id > sg.get_local_range().size()) return false;
+        size_t first_work_item_id = ctz64(mask);
+        if (first_work_item_id >= sg.get_local_range().size()) return false;
         const T from_others = sycl::select_from_group(sg, val, first_work_item_id);
-        return mask == (ballot(sg, val == from_others) & mask);
+        return mask == (ballot<max_sub_group_size>(sg, val == from_others) & mask);
     }
 #endif
 
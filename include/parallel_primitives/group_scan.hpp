@@ -0,0 +1,180 @@
+/**
+    Copyright 2021 Codeplay Software Ltd.
+
+    Licensed under the Apache License, Version 2.0 (the "License");
+    you may not use these files except in compliance with the License.
+    You may obtain a copy of the License at
+
+    http://www.apache.org/licenses/LICENSE-2.0
+
+    For your convenience, a copy of the License has been included in this
+    repository.
+
+    Unless required by applicable law or agreed to in writing, software
+    distributed under the License is distributed on an "AS IS" BASIS,
+    WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+    See the License for the specific language governing permissions and
+    limitations under the License.
+ */
+
+#pragma once
+
+#include "internal/common.h"
+#include "sub_group_scan.hpp"
+#include "../group_load_store.hpp"
+
+namespace parallel_primitives {
+
+    /**
+     * Work-group scan backends:
+     *  - automatic: picked from the device by select_group_scan_algorithm;
+     *  - sycl_joint: the SYCL joint_inclusive_scan/joint_exclusive_scan;
+     *  - raking: register tiles scanned serially, then a sub-group scan of the work-item totals and a fix-up pass.
+     */
+    enum class group_scan_algorithm {
+        automatic,
+        sycl_joint,
+        raking
+    };
+
+    /**
+     * The raking scan relies on sub-group shuffles and local memory banks, the SYCL implementation is kept elsewhere.
+     */
+    static inline group_scan_algorithm select_group_scan_algorithm(const sycl::device &dev, group_scan_algorithm requested = group_scan_algorithm::automatic) {
+        if (requested != group_scan_algorithm::automatic) return requested;
+        return dev.is_gpu() ? group_scan_algorithm::raking : group_scan_algorithm::sycl_joint;
+    }
+
+    namespace internal {
+        /**
+         * Elements per work-item of the raking scan tiles
+         */
+        constexpr size_t raking_items = 4;
+
+        /**
+         * Default software prefetch distance of the scan streaming loops, in tiles. 0 disables the prefetches, they are
+         * opt-in until benchmark_prefetch measures a gain on a device.
+         */
+        constexpr size_t scan_prefetch_distance = 0;
+    }
+
+    /**
+     * Number of elements of local memory raking_scan_over_group needs as scratch: the padded tile exchange buffer
+     * followed by the sub-group totals.
+     */
+    template<typename T, size_t K = internal::raking_items>
+    static inline constexpr size_t raking_scan_local_size(const size_t &group_size) {
+        return sycl::ext::group_load_store_local_size<T, K, sycl::ext::load_store_mode::transpose>(group_size) + group_size + 1;
+    }
+
+    /**
+     * Raking scan of length elements by the whole work-group. Each tile of K elements per work-item is loaded coalesced
+     * and transposed through padded local memory, scanned serially in registers, offset by a sub-group scan of the
+     * work-item totals, then stored back coalesced.
+     * @tparam prefetch_distance tiles ahead of the current one prefetched by each work-item, 0 to disable
+     * @param scratch local memory of raking_scan_local_size elements
+     * @return op(init, all the elements)
+     */
+    template<scan_type type, typename func, size_t K = internal::raking_items, sub_group_algorithm sg_algorithm = sub_group_algorithm::kogge_stone, size_t prefetch_distance = internal::scan_prefetch_distance, typename T>
+    static inline T raking_scan_over_group(const sycl::nd_item<1> &item, const T *in, T *out, const size_t &length, T *scratch, const T &init = internal::get_init<T, func>()) {
+        using sycl::ext::load_store_mode;
+        const func op{};
+        const T identity = internal::get_init<T, func>();
+        const auto sg = item.get_sub_group();
+        const size_t sg_id = sg.get_group_linear_id();
+        const size_t sg_count = sg.get_group_range().size();
+        const size_t sg_size = sg.get_local_range().size();
+        const size_t group_size = item.get_local_range().size();
+        const size_t tile_size = K * group_size;
+        T *sg_totals = scratch + sycl::ext::group_load_store_local_size<T, K, load_store_mode::transpose>(group_size);
+
+        T carry = init;
+        for (size_t offset = 0; offset < length; offset += tile_size) {
+            std::array<T, K> items;
+            sycl::ext::group_load<K, load_store_mode::transpose, prefetch_distance>(item, in + offset, length - offset, items, identity, scratch);
+
+            // Serial inclusive scan of the work-item's registers
+            T total = identity;
+#pragma unroll
+            for (size_t k = 0; k < K; ++k) {
+                total = op(total, items[k]);
+                items[k] = total;
+            }
+
+            // Offsets of the work-items: sub-group scan of their totals, then scan of the sub-group totals
+            const T thread_prefix = sub_group_scan<scan_type::exclusive, sg_algorithm>(sg, total, op);
+            if (sg.get_local_linear_id() == sg_size - 1) {
+                sg_totals[sg_id] = op(thread_prefix, total);
+            }
+            sycl::group_barrier(item.get_group());
+            if (sg_id == 0) {
+                T sg_carry = carry;
+                for (size_t chunk = 0; chunk < sg_count; chunk += sg_size) {
+                    const size_t idx = chunk + sg.get_local_linear_id();
+                    const T sg_total = idx < sg_count ? sg_totals[idx] : identity;
+                    const T prefix = sub_group_scan<scan_type::exclusive, sg_algorithm>(sg, sg_total, op, sg_carry);
+                    if (idx < sg_count) sg_totals[idx] = prefix;
+                    sg_carry = sycl::select_from_group(sg, op(prefix, sg_total), sg_size - 1);
+                }
+                if (sg.get_local_linear_id() == 0) sg_totals[sg_count] = sg_carry;
+            }
+            sycl::group_barrier(item.get_group());
+
+            // Fix-up
+            const T prefix = op(sg_totals[sg_id], thread_prefix);
+            if constexpr (type == scan_type::inclusive) {
+#pragma unroll
+                for (size_t k = 0; k < K; ++k) {
+                    items[k] = op(prefix, items[k]);
+                }
+            } else if constexpr (type == scan_type::exclusive) {
+#pragma unroll
+                for (size_t k = K - 1; k > 0; --k) {
+                    items[k] = op(prefix, items[k - 1]);
+                }
+                items[0] = prefix;
+            } else {
+                fail_to_compile<type, T, func>();
+            }
+            carry = sg_totals[sg_count];
+
+            sycl::ext::group_store<K, load_store_mode::transpose>(item, out + offset, length - offset, items, scratch); // Its barriers protect sg_totals
+        }
+        return carry;
+    }
+
+    namespace internal {
+        /**
+         * Work-group scan with the selected backend, scratch and prefetch_distance are only used by the raking scan.
+         * @return op(init, all the elements)
+         */
+        template<scan_type type, typename func, group_scan_algorithm algorithm, size_t prefetch_distance = scan_prefetch_distance, typename T>
+        static inline T group_scan(const sycl::nd_item<1> &item, const T *in, T *out, const size_t &length, T *scratch, const T &init = get_init<T, func>()) {
+            static_assert(algorithm != group_scan_algorithm::automatic, "The algorithm must be resolved with select_group_scan_algorithm");
+            if constexpr (algorithm == group_scan_algorithm::raking) {
+                return raking_scan_over_group<type, func, raking_items, sub_group_algorithm::kogge_stone, prefetch_distance>(item, in, out, length, scratch, init);
+            } else {
+                const func op{};
+                if (length == 0) return init;
+                if constexpr(type == scan_type::inclusive) {
+                    sycl::joint_inclusive_scan(item.get_group(), in, in + length, out, op, init);
+                    return out[length - 1];
+                } else if constexpr (type == scan_type::exclusive) {
+                    sycl::joint_exclusive_scan(item.get_group(), in, in + length, out, init, op);
+                    return op(out[length - 1], in[length - 1]);
+                } else {
+                    fail_to_compile<type, T, func>();
+                }
+            }
+        }
+
+        /**
+         * Local memory elements internal::group_scan needs
+         */
+        template<typename T, group_scan_algorithm algorithm>
+        static inline size_t group_scan_local_size(const size_t &group_size) {
+            return algorithm == group_scan_algorithm::raking ? raking_scan_local_size<T>(group_size) : 1;
+        }
+    }
+
+}
@@ -117,7 +117,7 @@ namespace parallel_primitives::decoupled_lookback_internal {
             const func op{};
             for (auto partition = partition_id; partition_id > 0;) {
                 partition--;
-                sycl::ext::prefetch(ptr_base + partition - 1);
+                if (partition > 0) sycl::ext::prefetch(ptr_base + partition - 1); // Next descriptor of the look-back
                 while (ptr_base[partition].status_flag_ == status::invalid) {/* wait */}
                 if (ptr_base[partition].status_flag_ == status::prefix_available) {
                     return op(tmp, ptr_base[partition].inclusive_prefix_);
@@ -23,40 +23,66 @@
 #include "../usm_smart_ptr.hpp"
 #include <numeric>
 #include <intrinsics.hpp>
+#include <group_load_store.hpp>
 
 using namespace usm_smart_ptr;
 
 namespace parallel_primitives {
     namespace internal {
 
-        template<typename T, typename func, int N>
+        /**
+         * Default software prefetch distance of the reduction kernel, in chunks. 0 disables the prefetches, they are opt-in
+         * until benchmark_prefetch measures a gain on a device.
+         */
+        constexpr size_t reduction_prefetch_distance = 0;
+
+        /**
+         * The reduction kernel streams its N elements per work-item by chunks of at most this many elements
+         */
+        constexpr int reduction_chunk_items = 8;
+
+        template<typename T, typename func, int N, size_t prefetch_distance>
         struct reduction_kernel;
 
-        template<typename func, typename T, int N>
+        template<typename func, typename T, int N, size_t prefetch_distance = reduction_prefetch_distance>
         static inline T reduce_device_impl(sycl::queue &q, const T *d_in, sycl::nd_range<1> kernel_range) {
             T reduced = get_init<T, func>();
             {
                 sycl::buffer<T> reducedBuf(&reduced, 1);
                 q.submit([&](sycl::handler &cgh) {
                     auto reduction = sycl::reduction(reducedBuf, cgh, func{});
-                    cgh.parallel_for<reduction_kernel<func, T, N>>(
+                    cgh.parallel_for<reduction_kernel<func, T, N, prefetch_distance>>(
                             kernel_range, reduction,
                             [d_in](sycl::nd_item<1> item, auto &reducer) {
 //                                const size_t size = item.get_sub_group().get_max_local_range().size();
 //                                const size_t global_offset = N * item.get_group_linear_id() * item.get_local_range().size();
 //                                const T *in = d_in + global_offset + N * size * (item.get_local_linear_id() / size) + item.get_local_linear_id() % (size);
-                                const uint size = item.get_local_range().size();
-                                const T *in = d_in + N * item.get_group_linear_id() * size + item.get_local_linear_id();
+                                constexpr int K = N < reduction_chunk_items ? N : reduction_chunk_items;
+                                constexpr int remainder = N % K;
+                                const size_t tile_size = N * item.get_local_range().size();
+                                const size_t chunk_size = K * item.get_local_range().size();
+                                const size_t full_chunks_size = (N / K) * chunk_size;
+                                const T *group_in = d_in + item.get_group_linear_id() * tile_size;
+                                const func op{};
+                                T partial = get_init<T, func>();
+                                // Coalesced and read once, the range only holds full tiles. The prefetches stay in the tile.
+                                for (size_t offset = 0; offset < full_chunks_size; offset += chunk_size) {
+                                    std::array<T, K> items;
+                                    sycl::ext::group_load<K, sycl::ext::load_store_mode::striped, prefetch_distance, sycl::ext::cache_hint::streaming>(item, group_in + offset, tile_size - offset, items);
+#pragma unroll
+                                    for (uint i = 0; i < K; ++i) {
+                                        partial = op(partial, items[i]);
+                                    }
+                                }
+                                if constexpr (remainder != 0) { // Last N % K elements of each work-item, nothing left to prefetch
+                                    std::array<T, remainder> items;
+                                    sycl::ext::group_load<remainder, sycl::ext::load_store_mode::striped, 0, sycl::ext::cache_hint::streaming>(item, group_in + full_chunks_size, tile_size - full_chunks_size, items);
 #pragma unroll
-                                for (uint i = 0; i < N; ++i) {
-                                    //auto tmp = sycl::reduce_over_group(item.get_sub_group(), in[i * size], func{});
-                                    //if (item.get_sub_group().leader()) {
-                                    //         reducer.combine(tmp);
-                                    //       }
-                                    auto tmp = in[i * size];
-                                    //item.barrier();
-                                    reducer.combine(tmp);
+                                    for (uint i = 0; i < remainder; ++i) {
+                                        partial = op(partial, items[i]);
+                                    }
                                 }
+                                reducer.combine(partial);
                             });
                 }).wait();
             }
@@ -75,7 +101,7 @@ namespace parallel_primitives {
         return out;
     }
 
-    template<typename func, typename T, int N, int decimation_factor = 4>
+    template<typename func, typename T, int N, int decimation_factor = 4, size_t prefetch_distance = internal::reduction_prefetch_distance>
     static inline T dispatch_kernel_call(sycl::queue &q, const T *input, index_t length, size_t max_items) {
         static_assert(N > 0 && N <= 256);
         static_assert(decimation_factor > 1);
@@ -88,11 +114,11 @@ namespace parallel_primitives {
             index_t group_count = (scaled_length / max_items);
             if (group_count > 0) {
                 sycl::nd_range<1> kernel_parameters(max_items * group_count, max_items);
-                out = op(out, internal::reduce_device_impl<func, T, N>(q, input, kernel_parameters));
+                out = op(out, internal::reduce_device_impl<func, T, N, prefetch_distance>(q, input, kernel_parameters));
                 processed += group_count * max_items * N;
             } else {
                 sycl::nd_range<1> kernel_parameters(scaled_length, scaled_length);
-                out = op(out, internal::reduce_device_impl<func, T, N>(q, input, kernel_parameters));
+                out = op(out, internal::reduce_device_impl<func, T, N, prefetch_distance>(q, input, kernel_parameters));
                 processed += scaled_length * N;
             }
         }
@@ -100,9 +126,9 @@ namespace parallel_primitives {
         if (processed != length) {
             size_t remainder = length - processed;
             if constexpr (N > decimation_factor) {
-                out = op(out, dispatch_kernel_call<func, T, N / decimation_factor>(q, input + processed, remainder, max_items));
+                out = op(out, dispatch_kernel_call<func, T, N / decimation_factor, decimation_factor, prefetch_distance>(q, input + processed, remainder, max_items));
             } else {
-                out = op(out, dispatch_kernel_call<func, T, 1>(q, input + processed, remainder, max_items));
+                out = op(out, dispatch_kernel_call<func, T, 1, decimation_factor, prefetch_distance>(q, input + processed, remainder, max_items));
             }
             processed += remainder;
         }
@@ -110,7 +136,10 @@ namespace parallel_primitives {
         return out;
     }
 
-    template<typename func, typename T, bool optimised_offload = true, size_t offload_threshold = 16384>
+    /**
+     * @tparam prefetch_distance software prefetch distance of the kernel loads, in chunks, 0 to disable
+     */
+    template<typename func, typename T, bool optimised_offload = true, size_t offload_threshold = 16384, size_t prefetch_distance = internal::reduction_prefetch_distance>
     T reduce_device(sycl::queue &q, const sycl::span<T> &input) {
         index_t max_items = (uint32_t) std::min(4096ul, std::max(1ul, q.get_device().get_info<sycl::info::device::max_work_group_size>())); // No more than 4096 items per reduction WG in DPC++
         const func op{};
@@ -132,7 +161,7 @@ namespace parallel_primitives {
                 out = op(out, host_reduce<func, T>(tmp));
                 free(tmp.data());
             } else {
-                out = op(out, dispatch_kernel_call<func, T, unroll_size, decimation_factor>(q, input.data() + processed, chunk_size, max_items));
+                out = op(out, dispatch_kernel_call<func, T, unroll_size, decimation_factor, prefetch_distance>(q, input.data() + processed, chunk_size, max_items));
             }
         }
         return out;
@@ -21,6 +21,7 @@
 
 
 #include "internal/common.h"
+#include "group_scan.hpp"
 #include "../usm_smart_ptr.hpp"
 #include <numeric>
 
@@ -29,21 +30,22 @@ using namespace usm_smart_ptr;
 namespace parallel_primitives {
     namespace internal {
 
-        template<scan_type t, typename T, typename func>
+        template<scan_type t, typename T, typename func, group_scan_algorithm algorithm, size_t prefetch_distance>
         struct scan_kernel_prescan;
 
         template<scan_type t, typename T, typename func>
         struct scan_kernel_propagate;
 
-        template<scan_type type, typename func, typename T>
+        template<scan_type type, typename func, group_scan_algorithm algorithm, size_t prefetch_distance = scan_prefetch_distance, typename T>
         static inline void scan_device_impl(sycl::queue &q, const T *d_in, T *d_out, index_t length, sycl::nd_range<1> kernel_range) {
             const size_t group_count = kernel_range.get_group_range().size();
+            auto group_totals = usm_unique_ptr<T, alloc::device>(group_count, q); // op of all the elements of each group
 
             q.submit([&](sycl::handler &cgh) {
-                cgh.parallel_for<scan_kernel_prescan<type, func, T>>(
+                local_accessor<T, 1> scratch(sycl::range<1>(group_scan_local_size<T, algorithm>(kernel_range.get_local_range().size())), cgh);
+                cgh.parallel_for<scan_kernel_prescan<type, func, T, algorithm, prefetch_distance>>(
                         kernel_range,
-                        [length, d_in, d_out](sycl::nd_item<1> item) {
-                            const func op{};
+                        [length, d_in, d_out, scratch, group_totals = group_totals.get()](sycl::nd_item<1> item) {
                             const size_t group_id = item.get_group_linear_id();
                             const size_t group_count = item.get_group_range().size();
                             const size_t group_global_offset = get_cumulative_work_size(group_count, group_id, length);
@@ -51,14 +53,12 @@ namespace parallel_primitives {
                             const T *group_in = d_in + group_global_offset;
                             T *group_out = d_out + group_global_offset;
                             // First pass: scans
+                            T total = get_init<T, func>();
                             if (group_global_offset + this_work_size <= length) {
-                                if constexpr(type == scan_type::inclusive) {
-                                    sycl::joint_inclusive_scan(item.get_group(), group_in, group_in + this_work_size, group_out, op, get_init<T, func>());
-                                } else if constexpr (type == scan_type::exclusive) {
-                                    sycl::joint_exclusive_scan(item.get_group(), group_in, group_in + this_work_size, group_out, get_init<T, func>(), op);
-                                } else {
-                                    fail_to_compile<type, T, func>();
-                                }
+                                total = group_scan<type, func, algorithm, prefetch_distance>(item, group_in, group_out, this_work_size, scratch.get_pointer());
+                            }
+                            if (item.get_local_linear_id() == 0) {
+                                group_totals[group_id] = total;
                             }
                         });
             }).wait();
@@ -68,9 +68,12 @@ namespace parallel_primitives {
                 return;
             }
 
+            // A single transfer of all the group totals, the carries are then scanned on the host
+            std::vector<T> totals(group_count);
+            q.memcpy(totals.data(), group_totals.get(), group_count * sizeof(T)).wait();
             std::vector<T> partial_scans(group_count, get_init<T, func>());
-            for (size_t c = 1; c <= group_count; c++) {
-                partial_scans[c] = op(partial_scans[c - 1], d_out[get_cumulative_work_size(group_count, c, length) - 1]);
+            for (size_t c = 1; c < group_count; c++) {
+                partial_scans[c] = op(partial_scans[c - 1], totals[c - 1]);
             }
             sycl::buffer<T> partial_scans_b(partial_scans.data(), sycl::range(group_count));
 
@@ -104,29 +107,42 @@ namespace parallel_primitives {
     }
 
 
-    template<scan_type type, typename func, typename T>
-    void scan_device(sycl::queue &q, const T *input, T *output, index_t length) {
-
-        auto max_kernel_items = std::min(
-                internal::get_max_work_items<internal::scan_kernel_propagate<type, func, T>>(q),
-                internal::get_max_work_items<internal::scan_kernel_prescan<type, func, T>>(q)
-        );
-
-        index_t max_items = std::min(4096ul, std::max(1ul, max_kernel_items)); // No more than 4096 items per reduction WG in DPC++
+    namespace internal {
+        template<scan_type type, typename func, group_scan_algorithm algorithm, size_t prefetch_distance, typename T>
+        void scan_device(sycl::queue &q, const T *input, T *output, index_t length) {
+            auto max_kernel_items = std::min(
+                    get_max_work_items<scan_kernel_propagate<type, func, T>>(q),
+                    get_max_work_items<scan_kernel_prescan<type, func, T, algorithm, prefetch_distance>>(q)
+            );
+
+            index_t max_items = std::min(4096ul, std::max(1ul, max_kernel_items)); // No more than 4096 items per reduction WG in DPC++
+
+            index_t sm_count = (uint32_t) q.get_device().get_info<sycl::info::device::max_compute_units>();
+            index_t work_ratio_per_item = 1024;
+            max_items = std::min(max_items, length);
+            sm_count = std::min(sm_count, (length + (work_ratio_per_item * max_items) - 1) / (work_ratio_per_item * max_items));
+            sycl::nd_range<1> kernel_parameters(max_items * sm_count, max_items);
+            scan_device_impl<type, func, algorithm, prefetch_distance>(q, input, output, length, kernel_parameters);
+        }
+    }
 
-        index_t sm_count = (uint32_t) q.get_device().get_info<sycl::info::device::max_compute_units>();
-        index_t work_ratio_per_item = 1024;
-        max_items = std::min(max_items, length);
-        sm_count = std::min(sm_count, (length + (work_ratio_per_item * max_items) - 1) / (work_ratio_per_item * max_items));
-        sycl::nd_range<1> kernel_parameters(max_items * sm_count, max_items);
-        internal::scan_device_impl<type, func>(q, input, output, length, kernel_parameters);
+    /**
+     * @tparam prefetch_distance software prefetch distance of the raking scan loads, in tiles, 0 to disable
+     */
+    template<scan_type type, typename func, typename T, size_t prefetch_distance = internal::scan_prefetch_distance>
+    void scan_device(sycl::queue &q, const T *input, T *output, index_t length, group_scan_algorithm algorithm = group_scan_algorithm::automatic) {
+        if (select_group_scan_algorithm(q.get_device(), algorithm) == group_scan_algorithm::raking) {
+            internal::scan_device<type, func, group_scan_algorithm::raking, prefetch_distance>(q, input, output, length);
+        } else {
+            internal::scan_device<type, func, group_scan_algorithm::sycl_joint, prefetch_distance>(q, input, output, length);
+        }
     }
 
     template<scan_type type, typename func, typename T>
     void group_scan_device(sycl::queue &q, const T *input, T *output, index_t length) {
         sycl::range<1> work_items = q.get_device().get_info<sycl::info::device::max_work_group_size>();
         sycl::nd_range<1> kernel_parameters = sycl::nd_range(work_items, work_items);
-        internal::scan_device_impl<type, func>(q, input, output, length, kernel_parameters);
+        internal::scan_device_impl<type, func, group_scan_algorithm::sycl_joint>(q, input, output, length, kernel_parameters);
     }
 
 
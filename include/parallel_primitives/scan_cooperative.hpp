@@ -21,6 +21,7 @@
 
 #include "internal/common.h"
 #include "../cooperative_groups.hpp"
+#include "../intrinsics.hpp"
 #include <numeric>
 #include "../usm_smart_ptr.hpp"
 
@@ -33,14 +34,13 @@ namespace parallel_primitives {
         struct cooperative_scan_kernel;
 
         template<scan_type type, typename func, typename T>
-        static inline void scan_cooperative_device(sycl::queue &q, const T *d_in, T *d_out, index_t length, sycl::nd_range<1> kernel_range) {
-            auto grid_barrier = nd_range_barrier<1>::make_barrier(q, kernel_range);
-            auto all_but_first_barrier = nd_range_barrier<1>::make_barrier(q, kernel_range, [](size_t i) { return i != 0; });
+        static inline void scan_cooperative_device(sycl::queue &q, const T *d_in, T *d_out, index_t length, sycl::nd_range<1> kernel_range, size_t groups_per_compute_unit = 1) {
+            auto collectives = nd_range_collectives<T, 1>::make_collectives(q, kernel_range, groups_per_compute_unit);
 
             q.submit([&](sycl::handler &cgh) {
                 cgh.parallel_for<cooperative_scan_kernel<type, func, T>>(
                         kernel_range,
-                        [length2 = length, d_in, d_out, grid_barrier, all_but_first_barrier](sycl::nd_item<1> item) {
+                        [length2 = length, d_in, d_out, collectives](sycl::nd_item<1> item) {
                             const size_t length = length2;
                             const func op{};
                             const size_t group_id = item.get_group_linear_id();
@@ -68,17 +68,20 @@ namespace parallel_primitives {
                                 return;
                             }
 
-                            // Second pass: compute the intermediary sums
-                            grid_barrier->wait(item);
-                            T prev = get_init<T, func>();
-                            if (group_global_offset + this_work_size <= length) {
-                                for (size_t c = 1; c <= group_id; c++) {
-                                    prev = op(prev, d_out[get_cumulative_work_size(group_count, c, length) - 1]);
+                            // Second pass: compute the intermediary sums with a grid-wide scan of the group aggregates
+                            for (size_t i = item_local_offset; i < this_work_size; i += group_size) {
+                                sycl::ext::prefetch(group_out + i); // Read back by the propagation once the grid-wide scan returns
+                            }
+                            T aggregate = get_init<T, func>();
+                            if (item_local_offset == 0 && this_work_size > 0) {
+                                aggregate = group_out[this_work_size - 1];
+                                if constexpr (type == scan_type::exclusive) {
+                                    aggregate = op(aggregate, group_in[this_work_size - 1]);
                                 }
                             }
+                            const T prev = sycl::group_broadcast(item.get_group(), grid_exclusive_scan(item, collectives, aggregate, op), 0);
 
-                            // Third phase: propagate the results
-                            all_but_first_barrier->wait(item); // The first group will never have to wait
+                            // Third phase: propagate the results, no other group reads this group's output anymore
                             if (group_global_offset + this_work_size <= length) {
                                 for (size_t i = item_local_offset; i < this_work_size; i += group_size) {
                                     group_out[i] = op(group_out[i], prev);
@@ -86,16 +89,16 @@ namespace parallel_primitives {
                             }
                         });
             }).wait();
-            sycl::free(grid_barrier, q);
-            sycl::free(all_but_first_barrier, q);
+            nd_range_collectives<T, 1>::free_collectives(collectives, q);
         }
     }
 
 
     template<scan_type type, typename func, typename T>
     void cooperative_scan_device(sycl::queue &q, const T *input, T *output, index_t length) {
-        sycl::nd_range<1> kernel_parameters = get_max_occupancy<internal::cooperative_scan_kernel<type, func, T>>(q);
-        internal::scan_cooperative_device<type, func>(q, input, output, length, kernel_parameters);
+        occupancy kernel_occupancy = get_occupancy<internal::cooperative_scan_kernel<type, func, T>>(q);
+        sycl::nd_range<1> kernel_parameters = kernel_occupancy.get_nd_range(nd_range_barrier<1>::max_group_count);
+        internal::scan_cooperative_device<type, func>(q, input, output, length, kernel_parameters, kernel_occupancy.groups_per_compute_unit);
     }
 
 
@@ -22,6 +22,9 @@
 #include "internal/partition_descriptor.h"
 #include "scan.hpp"
 #include "../cooperative_groups.hpp"
+#include "../group_load_store.hpp"
+#include "sub_group_scan.hpp"
+#include "group_scan.hpp"
 
 namespace parallel_primitives {
     namespace internal {
@@ -29,39 +32,41 @@ namespace parallel_primitives {
         using partition_descriptor = decoupled_lookback_internal::partition_descriptor_impl<T, func, false>;
         //using partition_descriptor = decoupled_lookback_internal::partition_descriptor_impl<T, func, (sizeof(decoupled_lookback_internal::data<T, func>) <= 8)>;
 
-        template<scan_type type, typename T, typename func>
-        static inline T scan_over_group(const sycl::nd_item<1> &item, const size_t &length, const T *in, T *out, const T init = get_init<T, func>()) {
-            if constexpr(type == scan_type::inclusive) {
-                sycl::joint_inclusive_scan(item.get_group(), in, in + length, out, func{}, init);
-            } else if constexpr (type == scan_type::exclusive) {
-                sycl::joint_exclusive_scan(item.get_group(), in, in + length, out, init, func{});
-            } else {
-                fail_to_compile<type, T, func>();
-            }
-            //item.barrier();
-            return out[length - 1];
+        template<scan_type type, typename T, typename func, group_scan_algorithm algorithm = group_scan_algorithm::sycl_joint, size_t prefetch_distance = scan_prefetch_distance>
+        static inline T scan_over_group(const sycl::nd_item<1> &item, const size_t &length, const T *in, T *out, T *scratch, const T init = get_init<T, func>()) {
+            return group_scan<type, func, algorithm, prefetch_distance>(item, in, out, length, scratch, init);
         }
 
-        template<scan_type type, typename T, typename func>
+        template<scan_type type, typename T, typename func, sub_group_algorithm algorithm = sub_group_algorithm::kogge_stone>
         static inline void scan_over_sub_group(const sycl::nd_item<1> &item, const size_t &length, T *inout, const size_t &thread_id, const size_t &thread_count, T *shared_data, T init = get_init<T, func>()) {
             const func op{};
-            const size_t subgroup_id = item.get_sub_group().get_group_linear_id();
-            const size_t subgroup_count = item.get_sub_group().get_group_range().size();
+            const auto sg = item.get_sub_group();
+            const size_t subgroup_id = sg.get_group_linear_id();
+            const size_t subgroup_count = sg.get_group_range().size();
             for (size_t i = thread_id; i < length; i += thread_count) {
                 item.barrier(sycl::access::fence_space::local_space);
+                const T scanned = sub_group_scan<scan_type::inclusive, algorithm>(sg, inout[i], op);
                 if constexpr(type == scan_type::inclusive) {
-                    inout[i] = sycl::inclusive_scan_over_group(item.get_sub_group(), inout[i], op);
+                    inout[i] = scanned;
                 } else if constexpr (type == scan_type::exclusive) {
-                    inout[i] = sycl::exclusive_scan_over_group(item.get_sub_group(), inout[i], op);
+                    const T previous = sycl::shift_group_right(sg, scanned, 1);
+                    inout[i] = sg.get_local_linear_id() == 0 ? get_init<T, func>() : previous;
                 } else {
                     fail_to_compile<type, T, func>();
                 }
-                if (item.get_sub_group().get_local_linear_id() == item.get_sub_group().get_local_range().size() - 1) { // is trailer
-                    shared_data[subgroup_id] = inout[i];
+                if (sg.get_local_linear_id() == sg.get_local_range().size() - 1) { // is trailer
+                    shared_data[subgroup_id] = scanned;
                 }
                 item.barrier(sycl::access::fence_space::local_space);
-                if (subgroup_id == 0) {
-                    sycl::joint_exclusive_scan(item.get_sub_group(), shared_data, shared_data + subgroup_count, shared_data, init, op);
+                if (subgroup_id == 0) { // Exclusive scan of the sub-group totals, sub-group sized chunk by chunk
+                    T carry = init;
+                    for (size_t chunk = 0; chunk < subgroup_count; chunk += sg.get_local_range().size()) {
+                        const size_t idx = chunk + sg.get_local_linear_id();
+                        const T total = idx < subgroup_count ? shared_data[idx] : get_init<T, func>();
+                        const T prefix = sub_group_scan<scan_type::exclusive, algorithm>(sg, total, op, carry);
+                        if (idx < subgroup_count) shared_data[idx] = prefix;
+                        carry = sycl::select_from_group(sg, op(prefix, total), sg.get_local_range().size() - 1);
+                    }
                 }
                 item.barrier(sycl::access::fence_space::local_space);
                 if (subgroup_id != 0) {
@@ -72,43 +77,70 @@ namespace parallel_primitives {
         }
 
 
-        template<typename T>
-        static inline void load_local(const T *in, const size_t &length, T *acc, const size_t &thread_id, const size_t &thread_count) {
-            for (size_t i = thread_id; i < length; i += thread_count) {
-                acc[i] = in[i];
+        /**
+         * Tile size of the local memory transfers, in elements per work-item
+         */
+        constexpr size_t local_transfer_items = 4;
+
+        /**
+         * Default software prefetch distance of decoupled_scan_device, in tiles: its partition transfers have always
+         * prefetched the next tile.
+         */
+        constexpr size_t decoupled_scan_prefetch_distance = 1;
+
+        template<typename T, size_t K = local_transfer_items, size_t prefetch_distance = decoupled_scan_prefetch_distance>
+        static inline void load_local(const sycl::nd_item<1> &item, const T *in, const size_t &length, T *acc) {
+            const size_t tile_size = K * item.get_local_range().size();
+            for (size_t offset = 0; offset < length; offset += tile_size) {
+                std::array<T, K> items;
+                sycl::ext::group_load<K, sycl::ext::load_store_mode::striped, prefetch_distance, sycl::ext::cache_hint::streaming>(item, in + offset, length - offset, items);
+                sycl::ext::group_store<K>(item, acc + offset, length - offset, items);
             }
         }
 
-        template<typename T, typename func>
-        static inline T load_local_and_reduce(const sycl::nd_item<1> &item, const T *in, const size_t &length, T *acc, const size_t &thread_id, const size_t &thread_count) {
+        template<typename T, typename func, size_t K = local_transfer_items, size_t prefetch_distance = decoupled_scan_prefetch_distance>
+        static inline T load_local_and_reduce(const sycl::nd_item<1> &item, const T *in, const size_t &length, T *acc) {
             const func op{};
+            const size_t tile_size = K * item.get_local_range().size();
             T reduced = get_init<T, func>();
-            for (size_t i = thread_id; i < length; i += thread_count) {
-                T tmp = in[i];
-                acc[i] = tmp;
-                reduced = op(reduced, tmp);
+            for (size_t offset = 0; offset < length; offset += tile_size) {
+                std::array<T, K> items;
+                sycl::ext::group_load<K, sycl::ext::load_store_mode::striped, prefetch_distance, sycl::ext::cache_hint::streaming>(item, in + offset, length - offset, items, get_init<T, func>());
+                sycl::ext::group_store<K>(item, acc + offset, length - offset, items);
+#pragma unroll
+                for (size_t k = 0; k < K; ++k) {
+                    reduced = op(reduced, items[k]);
+                }
             }
             return sycl::reduce_over_group(item.get_group(), reduced, op);
         }
 
-        template<typename T, typename func>
-        static inline void store_to_global_and_increment(T *out, const size_t &length, T *acc, const size_t &thread_id, const size_t &thread_count, const T &init) {
+        template<typename T, typename func, size_t K = local_transfer_items>
+        static inline void store_to_global_and_increment(const sycl::nd_item<1> &item, T *out, const size_t &length, const T *acc, const T &init) {
             const func op{};
-            for (size_t i = thread_id; i < length; i += thread_count) {
-                out[i] = op(acc[i], init);
+            const size_t tile_size = K * item.get_local_range().size();
+            for (size_t offset = 0; offset < length; offset += tile_size) {
+                std::array<T, K> items;
+                sycl::ext::group_load<K>(item, acc + offset, length - offset, items);
+#pragma unroll
+                for (size_t k = 0; k < K; ++k) {
+                    items[k] = op(items[k], init);
+                }
+                sycl::ext::group_store<K, sycl::ext::load_store_mode::striped, sycl::ext::cache_hint::streaming>(item, out + offset, length - offset, items);
             }
         }
 
 
-        template<scan_type t, typename T, typename func>
+        template<scan_type t, typename T, typename func, group_scan_algorithm algorithm, size_t prefetch_distance>
         struct decoupled_scan_kernel;
 
-        template<scan_type type, typename func, typename T>
+        template<scan_type type, typename func, group_scan_algorithm algorithm, size_t prefetch_distance = decoupled_scan_prefetch_distance, typename T>
         static inline void scan_decoupled_device(sycl::queue &q, const T *d_in, T *d_out, index_t length, sycl::nd_range<1> kernel_range) {
             size_t local_mem_length = q.get_device().get_info<sycl::info::device::local_mem_size>() / sizeof(T);
             //   std::cout << local_mem_length << std::endl;
             const size_t group_size = kernel_range.get_local_range().size();
-            local_mem_length -= group_size; // Correction for DPC++
+            const size_t scratch_length = group_scan_local_size<T, algorithm>(group_size);
+            local_mem_length -= group_size + scratch_length; // Correction for DPC++, and the group scan scratch
             local_mem_length = group_size * (local_mem_length / group_size);
 
             const size_t partition_count = (length + local_mem_length - 1) / local_mem_length;
@@ -120,10 +152,11 @@ namespace parallel_primitives {
                 sycl::accessor<T, 1, sycl::access::mode::read_write, sycl::access::target::local> shared_buf(sycl::range<1>(32), cgh);
                 sycl::accessor<T, 1, sycl::access::mode::read_write, sycl::access::target::local> shared_prefix(sycl::range<1>(1), cgh);
                 sycl::accessor<int, 1, sycl::access::mode::read_write, sycl::access::target::local> shared_ready_state(sycl::range<1>(1), cgh);
+                sycl::accessor<T, 1, sycl::access::mode::read_write, sycl::access::target::local> shared_scratch(sycl::range<1>(scratch_length), cgh);
                 cgh.depends_on(init);
-                cgh.parallel_for<decoupled_scan_kernel<type, func, T >>(
+                cgh.parallel_for<decoupled_scan_kernel<type, func, T, algorithm, prefetch_distance>>(
                         kernel_range,
-                        [length_ = length, d_in, d_out, local_mem_length, shared_mem, partitions, shared_ready_state, shared_prefix, shared_buf](sycl::nd_item<1> item) {
+                        [length_ = length, d_in, d_out, local_mem_length, shared_mem, partitions, shared_ready_state, shared_prefix, shared_buf, shared_scratch](sycl::nd_item<1> item) {
                             const size_t length = length_;
                             const size_t group_id = item.get_group_linear_id();
                             T *const shared_prefix_ptr = shared_prefix.get_pointer();
@@ -133,14 +166,15 @@ namespace parallel_primitives {
                             const size_t group_size = item.get_local_range().size();
                             const func op{};
                             T *shared = shared_mem.get_pointer();
+                            T *scratch = shared_scratch.get_pointer();
 
                             for (size_t partition_id = group_id; partition_id * local_mem_length < length; partition_id += group_count) {
                                 const T *group_in = d_in + partition_id * local_mem_length;
                                 T *group_out = d_out + partition_id * local_mem_length;
                                 size_t this_chunk_length = sycl::min(local_mem_length, length - partition_id * local_mem_length);
                                 auto partition = partitions + partition_id;
-                                sycl::ext::prefetch(partitions - 1);
                                 if (thread_id == 0) {
+                                    if (partition_id > 0) sycl::ext::prefetch(partition - 1); // Descriptor read by is_ready and the look-back
                                     auto res = partition_descriptor<T, func>::is_ready(partitions, partition_id);
                                     if (res) {
                                         *ready_state_ptr = true;
@@ -152,16 +186,16 @@ namespace parallel_primitives {
                                 item.barrier(sycl::access::fence_space::local_space);
 
                                 if (shared_ready_state[0] == true) {
-                                    T aggregate = load_local_and_reduce<T, func>(item, group_in, this_chunk_length, shared, thread_id, group_size);
+                                    T aggregate = load_local_and_reduce<T, func, local_transfer_items, prefetch_distance>(item, group_in, this_chunk_length, shared);
                                     if (thread_id == 0) {
                                         partition->set_prefix(op(aggregate, *shared_prefix_ptr));
                                     }
-                                    scan_over_group<type, T, func>(item, this_chunk_length, shared, group_out, *shared_prefix_ptr);
+                                    scan_over_group<type, T, func, algorithm, prefetch_distance>(item, this_chunk_length, shared, group_out, scratch, *shared_prefix_ptr);
                                     //scan_over_sub_group<type, T, func>(item, this_chunk_length, shared, thread_id, group_size, shared_buf.get_pointer(), *shared_prefix_ptr);
-                                    //store_to_global_and_increment<T, func>(group_out, this_chunk_length, shared, thread_id, group_size);
+                                    //store_to_global_and_increment<T, func>(item, group_out, this_chunk_length, shared, *shared_prefix_ptr);
                                 } else {
-                                    T aggregate = scan_over_group<type, T, func>(item, this_chunk_length, group_in, shared);
-                                    //load_local<T>(group_in, this_chunk_length, shared, thread_id, group_size);
+                                    T aggregate = scan_over_group<type, T, func, algorithm, prefetch_distance>(item, this_chunk_length, group_in, shared, scratch);
+                                    //load_local<T>(item, group_in, this_chunk_length, shared);
                                     //scan_over_sub_group<type, T, func>(item, this_chunk_length, shared, thread_id, group_size, shared_buf.get_pointer());
                                     if (thread_id == 0) {
                                         //  T aggregate = shared_buf[item.get_sub_group().get_group_range().size() - 1];
@@ -170,7 +204,7 @@ namespace parallel_primitives {
                                         partition->set_prefix(op(aggregate, *shared_prefix_ptr));
                                     }
                                     item.barrier(sycl::access::fence_space::local_space);
-                                    store_to_global_and_increment<T, func>(group_out, this_chunk_length, shared, thread_id, group_size, *shared_prefix_ptr);
+                                    store_to_global_and_increment<T, func>(item, group_out, this_chunk_length, shared, *shared_prefix_ptr);
                                 }
                             }
                         });
@@ -206,14 +240,25 @@ namespace parallel_primitives {
         }
     }
 
-    template<scan_type type, typename func, typename T, bool optimised_offload = true>
-    void decoupled_scan_device(sycl::queue &q, const T *input, T *output, index_t length) {
+    /**
+     * @tparam prefetch_distance software prefetch distance of the partition loads and of the raking scan tiles, in tiles,
+     * 0 to disable
+     */
+    template<scan_type type, typename func, typename T, bool optimised_offload = true, size_t prefetch_distance = internal::decoupled_scan_prefetch_distance>
+    void decoupled_scan_device(sycl::queue &q, const T *input, T *output, index_t length, group_scan_algorithm algorithm = group_scan_algorithm::automatic) {
         if (optimised_offload && length < 65536 && q.get_device().is_gpu()) {
-            return scan_device<type, func, T>(q, input, output, length);
+            return scan_device<type, func, T, prefetch_distance>(q, input, output, length, algorithm);
         }
 
-        sycl::nd_range<1> kernel_parameters = get_max_occupancy<internal::decoupled_scan_kernel<type, func, T>>(q);
-        internal::scan_decoupled_device<type, func>(q, input, output, length, kernel_parameters);
+        // The kernel fills the local memory to size its partitions
+        const size_t local_mem_size = q.get_device().get_info<sycl::info::device::local_mem_size>();
+        if (select_group_scan_algorithm(q.get_device(), algorithm) == group_scan_algorithm::raking) {
+            sycl::nd_range<1> kernel_parameters = get_max_occupancy<internal::decoupled_scan_kernel<type, func, T, group_scan_algorithm::raking, prefetch_distance>>(q, local_mem_size);
+            internal::scan_decoupled_device<type, func, group_scan_algorithm::raking, prefetch_distance>(q, input, output, length, kernel_parameters);
+        } else {
+            sycl::nd_range<1> kernel_parameters = get_max_occupancy<internal::decoupled_scan_kernel<type, func, T, group_scan_algorithm::sycl_joint, prefetch_distance>>(q, local_mem_size);
+            internal::scan_decoupled_device<type, func, group_scan_algorithm::sycl_joint, prefetch_distance>(q, input, output, length, kernel_parameters);
+        }
     }
 
     template<scan_type type, typename func, typename T, bool optimised_offload = true, size_t offload_threshold = 131072>
@@ -0,0 +1,128 @@
+/**
+    Copyright 2021 Codeplay Software Ltd.
+
+    Licensed under the Apache License, Version 2.0 (the "License");
+    you may not use these files except in compliance with the License.
+    You may obtain a copy of the License at
+
+    http://www.apache.org/licenses/LICENSE-2.0
+
+    For your convenience, a copy of the License has been included in this
+    repository.
+
+    Unless required by applicable law or agreed to in writing, software
+    distributed under the License is distributed on an "AS IS" BASIS,
+    WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+    See the License for the specific language governing permissions and
+    limitations under the License.
+ */
+
+#pragma once
+
+#include "internal/common.h"
+#include "../intrinsics.hpp"
+
+namespace parallel_primitives {
+
+    /**
+     * Sub-group scan and reduction backends:
+     *  - sycl_builtin: the SYCL group algorithms;
+     *  - kogge_stone: log2(n) shuffle steps, each work-item combines at every step;
+     *  - brent_kung: 2 * log2(n) shuffle steps but half the combinations, for expensive operators.
+     */
+    enum class sub_group_algorithm {
+        sycl_builtin,
+        kogge_stone,
+        brent_kung
+    };
+
+    namespace internal {
+
+        template<size_t max_sub_group_size, typename T, typename func>
+        static inline T kogge_stone_inclusive_scan(const sycl::sub_group &sg, T value, const func &op) {
+            const uint32_t size = sg.get_local_range().size();
+            const uint32_t lane = sg.get_local_linear_id();
+#pragma unroll
+            for (uint32_t offset = 1; offset < max_sub_group_size; offset <<= 1) {
+                if (offset >= size) break; // Uniform
+                const T other = sycl::shift_group_right(sg, value, offset);
+                if (lane >= offset) value = op(other, value);
+            }
+            return value;
+        }
+
+        template<size_t max_sub_group_size, typename T, typename func>
+        static inline T brent_kung_inclusive_scan(const sycl::sub_group &sg, T value, const func &op) {
+            const uint32_t size = sg.get_local_range().size();
+            const uint32_t lane = sg.get_local_linear_id();
+            // Up-sweep: the work-items 2d - 1 mod 2d accumulate the partial sum of their 2d-wide block
+#pragma unroll
+            for (uint32_t d = 1; d < max_sub_group_size; d <<= 1) {
+                if (d >= size) break;
+                const T other = sycl::shift_group_right(sg, value, d);
+                if ((lane + 1) % (2 * d) == 0) value = op(other, value);
+            }
+            // Down-sweep: each block sum is pushed to the middle of the next block
+#pragma unroll
+            for (uint32_t d = max_sub_group_size / 4; d > 0; d >>= 1) {
+                if (2 * d >= size) continue;
+                const T other = sycl::shift_group_right(sg, value, d);
+                if (lane >= 3 * d - 1 && (lane + 1 - d) % (2 * d) == 0) value = op(other, value);
+            }
+            return value;
+        }
+    }
+
+    /**
+     * Register-only sub-group scan, the result of each work-item is combined with init.
+     * Must be called by the whole sub-group.
+     * @tparam max_sub_group_size upper bound of the sub-group size, sets the number of unrolled steps
+     */
+    template<scan_type type, sub_group_algorithm algorithm = sub_group_algorithm::kogge_stone, size_t max_sub_group_size = SYCL_EXT_MAX_SUB_GROUP_SIZE, typename T, typename func>
+    static inline T sub_group_scan(const sycl::sub_group &sg, const T &value, const func &op, const T &init = internal::get_init<T, func>()) {
+        static_assert(type == scan_type::inclusive || type == scan_type::exclusive);
+        if constexpr (algorithm == sub_group_algorithm::sycl_builtin) {
+            if constexpr (type == scan_type::inclusive) {
+                return sycl::inclusive_scan_over_group(sg, value, op, init);
+            } else {
+                return sycl::exclusive_scan_over_group(sg, value, init, op);
+            }
+        } else {
+            T inclusive;
+            if constexpr (algorithm == sub_group_algorithm::kogge_stone) {
+                inclusive = internal::kogge_stone_inclusive_scan<max_sub_group_size>(sg, value, op);
+            } else {
+                inclusive = internal::brent_kung_inclusive_scan<max_sub_group_size>(sg, value, op);
+            }
+            if constexpr (type == scan_type::inclusive) {
+                return op(init, inclusive);
+            } else {
+                const T previous = sycl::shift_group_right(sg, inclusive, 1);
+                return sg.get_local_linear_id() == 0 ? init : op(init, previous);
+            }
+        }
+    }
+
+    /**
+     * Register-only sub-group reduction, every work-item gets the result. Must be called by the whole sub-group.
+     */
+    template<sub_group_algorithm algorithm = sub_group_algorithm::kogge_stone, size_t max_sub_group_size = SYCL_EXT_MAX_SUB_GROUP_SIZE, typename T, typename func>
+    static inline T sub_group_reduce(const sycl::sub_group &sg, T value, const func &op) {
+        if constexpr (algorithm == sub_group_algorithm::sycl_builtin) {
+            return sycl::reduce_over_group(sg, value, op);
+        } else {
+            const uint32_t size = sg.get_local_range().size();
+            if ((size & (size - 1)) == 0) { // Butterfly, every work-item ends up with the full reduction
+#pragma unroll
+                for (uint32_t mask = 1; mask < max_sub_group_size; mask <<= 1) { // Contiguous blocks, keeps the operand order
+                    if (mask >= size) break;
+                    const T other = sycl::permute_group_by_xor(sg, value, mask);
+                    value = (sg.get_local_linear_id() & mask) ? op(other, value) : op(value, other);
+                }
+                return value;
+            }
+            return sycl::select_from_group(sg, sub_group_scan<scan_type::inclusive, algorithm, max_sub_group_size>(sg, value, op), size - 1);
+        }
+    }
+
+}
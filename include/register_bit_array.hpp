@@ -133,26 +133,12 @@ private:
 
     static constexpr uint32_t get_storage_word_count();
 
-    /**
-    * @see https://graphics.stanford.edu/~seander/bithacks.html#CountBitsSetKernighan
-    */
-    static constexpr inline uint popcount_kerninghan(storage_type v);
-
     std::array<storage_type, get_storage_word_count()> storage_array_{};
     static_assert(std::is_unsigned_v<storage_type> && std::is_integral_v<storage_type>);
     static_assert(generate_low_bit_mask(10) == storage_type(0b1111111111));
 };
 
 
-template<int N, typename storage_type>
-constexpr uint register_bit_array<N, storage_type>::popcount_kerninghan(storage_type v) {
-    uint c; // c accumulates the total bits set in v
-    for (c = 0U; v; c++) {
-        v &= v - 1U; // clear the least significant bit set
-    }
-    return c;
-}
-
 template<int N, typename storage_type>
 constexpr uint32_t register_bit_array<N, storage_type>::get_storage_word_count() {
     return (N + word_bit_size() - 1) / word_bit_size();
@@ -194,15 +180,11 @@ constexpr bool register_bit_array<N, storage_type>::test(const uint &idx) const
      * The point of this structure is to force register storage of the data so we cannot address the data.
      * Given that we're performing register lookup, for small register numbers, a linear search is the fastest
      * way, for bigger sizes, a dichotomic search performs better. (logarithmic complexity). But... that's a lot
-     * of registers to go through. You'd be better using shared memory.
+     * of registers to go through. The crossover table of the target picks between the two, never the stack.
      */
-    if constexpr(get_storage_word_count() > 64) {
-        storage_type word = sycl::ext::runtime_index_wrapper_log(storage_array_, idx / word_bit_size());
-        return sycl::ext::read_bit(word, idx % word_bit_size());
-    } else {
-        storage_type word = sycl::ext::runtime_index_wrapper(storage_array_, idx / word_bit_size());
-        return sycl::ext::read_bit(word, idx % word_bit_size());
-    }
+    constexpr auto strategy = sycl::ext::select_register_only_strategy<storage_type, get_storage_word_count()>();
+    storage_type word = sycl::ext::runtime_index_wrapper<strategy>(storage_array_, idx / word_bit_size());
+    return sycl::ext::read_bit(word, idx % word_bit_size());
 }
 
 template<int N, typename storage_type>
@@ -271,11 +253,12 @@ constexpr register_bit_array<N, storage_type> &register_bit_array<N, storage_typ
 template<int N, typename storage_type>
 constexpr register_bit_array<N, storage_type> &register_bit_array<N, storage_type>::write(const uint &idx, bool val) noexcept {
     assume(idx < size());
-    if (val) {
-        set(idx);
-    } else {
-        reset(idx);
-    }
+    sycl::ext::runtime_index_wrapper_transform_ith(
+            storage_array_,
+            idx / word_bit_size(),
+            [&](const storage_type &word) {
+                return sycl::ext::set_bit_in_word(word, idx % word_bit_size(), val); /* Bitfield insert, no branch on val */
+            });
     return *this;
 }
 
@@ -297,11 +280,12 @@ constexpr uint32_t register_bit_array<N, storage_type>::count() const noexcept {
                 if constexpr(std::is_same_v<storage_type, bool>) {
                     if (word) ++counter;
                 } else {
-#ifdef SYCL_DEVICE_ONLY
-                    counter += sycl::popcount(word); // All extra bits in the storage word are set to 0
-#else
-                    counter += popcount_kerninghan(word);
-#endif
+                    // All extra bits in the storage word are set to 0
+                    if constexpr (sizeof(storage_type) > sizeof(uint32_t)) {
+                        counter += sycl::ext::popc64(word);
+                    } else {
+                        counter += sycl::ext::popc32(word);
+                    }
                 }
             });
     return counter;
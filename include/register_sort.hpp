@@ -0,0 +1,198 @@
+/**
+    Copyright 2021 Codeplay Software Ltd.
+
+    Licensed under the Apache License, Version 2.0 (the "License");
+    you may not use these files except in compliance with the License.
+    You may obtain a copy of the License at
+
+    http://www.apache.org/licenses/LICENSE-2.0
+
+    For your convenience, a copy of the License has been included in this
+    repository.
+
+    Unless required by applicable law or agreed to in writing, software
+    distributed under the License is distributed on an "AS IS" BASIS,
+    WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+    See the License for the specific language governing permissions and
+    limitations under the License.
+ */
+
+#pragma once
+
+#include <sycl/sycl.hpp>
+#include <array>
+#include <functional>
+#include <utility>
+
+namespace sycl::ext {
+
+    /**
+     * Sorting networks available to register_sort. Every network is a fixed sequence of compare-exchanges on constant
+     * indices, so the sorted array stays in registers. None of them is stable.
+     * - optimal: the smallest known networks up to 8 elements, odd_even_merge above;
+     * - odd_even_merge: Batcher's odd-even merge sort, O(N log^2 N) compare-exchanges;
+     * - bitonic: bitonic sort, a few more compare-exchanges than odd_even_merge but a regular structure.
+     * Sizes that are not a power of two use the network of the next power of two without the compare-exchanges that
+     * touch the padding.
+     */
+    enum class sorting_network {
+        optimal,
+        odd_even_merge,
+        bitonic
+    };
+
+    namespace register_sort_internal {
+        struct comparator {
+            size_t lo;
+            size_t hi;
+        };
+
+        constexpr comparator optimal_2[] = {{0, 1}};
+        constexpr comparator optimal_3[] = {{1, 2}, {0, 2}, {0, 1}};
+        constexpr comparator optimal_4[] = {{0, 1}, {2, 3}, {0, 2}, {1, 3}, {1, 2}};
+        constexpr comparator optimal_5[] = {{0, 1}, {3, 4}, {2, 4}, {2, 3}, {0, 3}, {0, 2}, {1, 4}, {1, 3}, {1, 2}};
+        constexpr comparator optimal_6[] = {{1, 2}, {4, 5}, {0, 2}, {3, 5}, {0, 1}, {3, 4}, {2, 5}, {0, 3}, {1, 4}, {2, 4}, {1, 3}, {2, 3}};
+        constexpr comparator optimal_7[] = {{1, 2}, {3, 4}, {5, 6}, {0, 2}, {3, 5}, {4, 6}, {0, 1}, {4, 5}, {2, 6}, {0, 4}, {1, 5}, {0, 3}, {2, 5}, {1, 3}, {2, 4}, {2, 3}};
+        constexpr comparator optimal_8[] = {{0, 2}, {1, 3}, {4, 6}, {5, 7}, {0, 4}, {1, 5}, {2, 6}, {3, 7}, {0, 1}, {2, 3}, {4, 5}, {6, 7}, {2, 4}, {3, 5}, {1, 4}, {3, 6}, {1, 2}, {3, 4}, {5, 6}};
+
+        template<size_t count, typename visitor>
+        constexpr void visit_table(const comparator (&table)[count], visitor &visit) {
+            for (size_t c = 0; c < count; ++c) visit(table[c]);
+        }
+
+        /**
+         * Calls visit on every compare-exchange of the network sorting n elements, in order
+         */
+        template<typename visitor>
+        constexpr void visit_network(const sorting_network &network, const size_t &n, visitor &&visit) {
+            if (network == sorting_network::optimal && n <= 8) {
+                switch (n) {
+                    case 2: visit_table(optimal_2, visit); break;
+                    case 3: visit_table(optimal_3, visit); break;
+                    case 4: visit_table(optimal_4, visit); break;
+                    case 5: visit_table(optimal_5, visit); break;
+                    case 6: visit_table(optimal_6, visit); break;
+                    case 7: visit_table(optimal_7, visit); break;
+                    case 8: visit_table(optimal_8, visit); break;
+                    default: break;
+                }
+                return;
+            }
+
+            size_t padded = 1;
+            while (padded < n) padded *= 2;
+            auto emit = [&](const size_t &lo, const size_t &hi) {
+                if (hi < n) visit(comparator{lo, hi});
+            };
+
+            if (network == sorting_network::bitonic) {
+                // Variant with all the compare-exchanges in the same direction: the first step of each merge compares
+                // mirrored elements, which is what allows dropping the padding.
+                for (size_t k = 2; k <= padded; k *= 2) {
+                    for (size_t i = 0; i < padded; ++i) {
+                        if ((i ^ (k - 1)) > i) emit(i, i ^ (k - 1));
+                    }
+                    for (size_t j = k / 4; j > 0; j /= 2) {
+                        for (size_t i = 0; i < padded; ++i) {
+                            if ((i ^ j) > i) emit(i, i ^ j);
+                        }
+                    }
+                }
+            } else {
+                for (size_t p = 1; p < padded; p *= 2) {
+                    for (size_t k = p; k >= 1; k /= 2) {
+                        for (size_t j = k % p; j + k < padded; j += 2 * k) {
+                            for (size_t i = 0; i < k && i + j + k < padded; ++i) {
+                                if ((i + j) / (2 * p) == (i + j + k) / (2 * p)) emit(i + j, i + j + k);
+                            }
+                        }
+                    }
+                }
+            }
+        }
+
+        template<sorting_network network, size_t N>
+        constexpr size_t network_size() {
+            size_t count = 0;
+            visit_network(network, N, [&](const comparator &) { ++count; });
+            return count;
+        }
+
+        template<sorting_network network, size_t N>
+        constexpr std::array<comparator, network_size<network, N>()> make_network() {
+            std::array<comparator, network_size<network, N>()> out{};
+            size_t c = 0;
+            visit_network(network, N, [&](const comparator &comp) { out[c++] = comp; });
+            return out;
+        }
+
+        template<sorting_network network, size_t N>
+        inline constexpr auto network_v = make_network<network, N>();
+
+        template<size_t lo, size_t hi, typename T, typename array_t, typename Compare>
+        static inline constexpr void compare_exchange(array_t &arr, const Compare &comp) {
+            const T a = arr[lo];
+            const T b = arr[hi];
+            const bool swap = comp(b, a);
+            arr[lo] = swap ? b : a;
+            arr[hi] = swap ? a : b;
+        }
+
+        template<size_t lo, size_t hi, typename K, typename V, typename keys_t, typename values_t, typename Compare>
+        static inline constexpr void compare_exchange_by_key(keys_t &keys, values_t &values, const Compare &comp) {
+            const K a = keys[lo];
+            const K b = keys[hi];
+            const V va = values[lo];
+            const V vb = values[hi];
+            const bool swap = comp(b, a);
+            keys[lo] = swap ? b : a;
+            keys[hi] = swap ? a : b;
+            values[lo] = swap ? vb : va;
+            values[hi] = swap ? va : vb;
+        }
+
+        template<sorting_network network, size_t N, typename T, typename array_t, typename Compare, size_t... I>
+        static inline constexpr void apply_network(array_t &arr, const Compare &comp, std::index_sequence<I...>) {
+            (compare_exchange<network_v<network, N>[I].lo, network_v<network, N>[I].hi, T>(arr, comp), ...);
+        }
+
+        template<sorting_network network, size_t N, typename K, typename V, typename keys_t, typename values_t, typename Compare, size_t... I>
+        static inline constexpr void apply_network_by_key(keys_t &keys, values_t &values, const Compare &comp, std::index_sequence<I...>) {
+            (compare_exchange_by_key<network_v<network, N>[I].lo, network_v<network, N>[I].hi, K, V>(keys, values, comp), ...);
+        }
+    }
+
+    /**
+     * Number of compare-exchanges of the network used to sort N elements
+     */
+    template<sorting_network network, size_t N>
+    inline constexpr size_t sorting_network_size = register_sort_internal::network_size<network, N>();
+
+    /**
+     * Sorts arr with a sorting network: every access uses a constant index, so a registerized array is not spilled.
+     * @param comp strict weak ordering, the array is sorted so that comp(arr[i + 1], arr[i]) is false
+     */
+    template<sorting_network network = sorting_network::optimal, typename T, size_t N, typename Compare = std::less<T>>
+    static inline constexpr void register_sort(std::array<T, N> &arr, const Compare &comp = {}) {
+        register_sort_internal::apply_network<network, N, T>(arr, comp, std::make_index_sequence<sorting_network_size<network, N>>{});
+    }
+
+    template<sorting_network network = sorting_network::optimal, typename T, size_t N, typename Compare = std::less<T>>
+    static inline constexpr void register_sort(T (&arr)[N], const Compare &comp = {}) {
+        register_sort_internal::apply_network<network, N, T>(arr, comp, std::make_index_sequence<sorting_network_size<network, N>>{});
+    }
+
+    /**
+     * Sorts keys with a sorting network and applies the same permutation to values
+     */
+    template<sorting_network network = sorting_network::optimal, typename K, typename V, size_t N, typename Compare = std::less<K>>
+    static inline constexpr void register_sort_by_key(std::array<K, N> &keys, std::array<V, N> &values, const Compare &comp = {}) {
+        register_sort_internal::apply_network_by_key<network, N, K, V>(keys, values, comp, std::make_index_sequence<sorting_network_size<network, N>>{});
+    }
+
+    template<sorting_network network = sorting_network::optimal, typename K, typename V, size_t N, typename Compare = std::less<K>>
+    static inline constexpr void register_sort_by_key(K (&keys)[N], V (&values)[N], const Compare &comp = {}) {
+        register_sort_internal::apply_network_by_key<network, N, K, V>(keys, values, comp, std::make_index_sequence<sorting_network_size<network, N>>{});
+    }
+
+}
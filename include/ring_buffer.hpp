@@ -0,0 +1,200 @@
+/**
+    Copyright 2021 Codeplay Software Ltd.
+
+    Licensed under the Apache License, Version 2.0 (the "License");
+    you may not use these files except in compliance with the License.
+    You may obtain a copy of the License at
+
+    http://www.apache.org/licenses/LICENSE-2.0
+
+    For your convenience, a copy of the License has been included in this
+    repository.
+
+    Unless required by applicable law or agreed to in writing, software
+    distributed under the License is distributed on an "AS IS" BASIS,
+    WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+    See the License for the specific language governing permissions and
+    limitations under the License.
+ */
+
+#pragma once
+
+#include <sycl/sycl.hpp>
+#include <intrinsics.hpp>
+
+/**
+ * Bounded multi-producer/multi-consumer queue in USM, usable from kernels.
+ * A shared counter of the elements guarantees that a reservation always gets a slot, the head and tail counters then
+ * hand out tickets, and each slot carries a sequence number telling which ticket may use it (Broker Queue design).
+ * Producers and consumers that reserved a ticket may spin until the previous owner of the slot is done, so all the
+ * work-items using the queue must be resident (for example a grid sized with get_max_occupancy).
+ * @see https://arbook.icg.tugraz.at/schmalstieg/Schmalstieg_353.pdf
+ * @tparam T type of the elements, must be trivially copyable
+ */
+template<typename T>
+class mpmc_ring_buffer {
+private:
+    template<sycl::memory_order order>
+    using atomic_ref_t = sycl::atomic_ref<
+            size_t,
+            order,
+            sycl::memory_scope::device,
+            sycl::access::address_space::global_space
+    >;
+
+    T *values_;
+    size_t *sequences_;
+    size_t capacity_;
+    size_t count_ = 0;
+    size_t head_ = 0;
+    size_t tail_ = 0;
+
+    mpmc_ring_buffer(T *values, size_t *sequences, size_t capacity) : values_(values), sequences_(sequences), capacity_(capacity) {}
+
+    /**
+     * Reserves up to requested free slots
+     * @return the number of slots granted
+     */
+    size_t reserve_push(const size_t &requested) {
+        atomic_ref_t<sycl::memory_order::relaxed> count_ref(count_);
+        size_t count = count_ref.load();
+        while (count < capacity_) {
+            size_t granted = sycl::min(requested, capacity_ - count);
+            if (count_ref.compare_exchange_weak(count, count + granted)) {
+                return granted;
+            }
+        }
+        return 0;
+    }
+
+    /**
+     * Reserves up to requested elements
+     * @return the number of elements granted
+     */
+    size_t reserve_pop(const size_t &requested) {
+        atomic_ref_t<sycl::memory_order::relaxed> count_ref(count_);
+        size_t count = count_ref.load();
+        while (count > 0) {
+            size_t granted = sycl::min(requested, count);
+            if (count_ref.compare_exchange_weak(count, count - granted)) {
+                return granted;
+            }
+        }
+        return 0;
+    }
+
+    void write_ticket(const size_t &ticket, const T &value) {
+        atomic_ref_t<sycl::memory_order::acq_rel> sequence_ref(sequences_[ticket % capacity_]);
+        while (sequence_ref.load() != ticket) {} // Waiting for the consumer of the previous round
+        values_[ticket % capacity_] = value;
+        sequence_ref.store(ticket + 1);
+    }
+
+    T read_ticket(const size_t &ticket) {
+        atomic_ref_t<sycl::memory_order::acq_rel> sequence_ref(sequences_[ticket % capacity_]);
+        while (sequence_ref.load() != ticket + 1) {} // Waiting for the producer of this round
+        T value = values_[ticket % capacity_];
+        sequence_ref.store(ticket + capacity_);
+        return value;
+    }
+
+    size_t take_tickets(size_t &counter, const size_t &count) {
+        atomic_ref_t<sycl::memory_order::relaxed> counter_ref(counter);
+        return counter_ref.fetch_add(count);
+    }
+
+public:
+
+    /**
+     * Constructor helper, the ring buffer must be released with free_ring_buffer
+     */
+    static mpmc_ring_buffer<T> *make_ring_buffer(sycl::queue &q, size_t capacity) {
+        static_assert(std::is_trivially_copyable_v<T>);
+        auto values = sycl::malloc_device<T>(capacity, q);
+        auto sequences = sycl::malloc_shared<size_t>(capacity, q);
+        for (size_t i = 0; i < capacity; ++i) {
+            sequences[i] = i;
+        }
+        auto ring_buffer = sycl::malloc_shared<mpmc_ring_buffer<T>>(1, q);
+        return new(ring_buffer) mpmc_ring_buffer<T>(values, sequences, capacity);
+    }
+
+    static void free_ring_buffer(mpmc_ring_buffer<T> *ring_buffer, sycl::queue &q) {
+        sycl::free(ring_buffer->values_, q);
+        sycl::free(ring_buffer->sequences_, q);
+        sycl::free(ring_buffer, q);
+    }
+
+    [[nodiscard]] size_t capacity() const {
+        return capacity_;
+    }
+
+    /**
+     * Number of elements, only exact when no kernel is using the queue.
+     */
+    [[nodiscard]] size_t size() const {
+        return count_;
+    }
+
+    /**
+     * Pushes a value from a single work-item
+     * @return false if the queue was full
+     */
+    bool try_push(const T &value) {
+        if (reserve_push(1) == 0) return false;
+        write_ticket(take_tickets(tail_, 1), value);
+        return true;
+    }
+
+    /**
+     * Pops a value from a single work-item
+     * @return false if the queue was empty
+     */
+    bool try_pop(T &value) {
+        if (reserve_pop(1) == 0) return false;
+        value = read_ticket(take_tickets(head_, 1));
+        return true;
+    }
+
+#ifndef SYCL_IMPLEMENTATION_HIPSYCL
+
+    /**
+     * Pushes the values of the active work-items of the sub-group with a single reservation. Must be called by the whole sub-group.
+     * @return false if the queue was full for this work-item
+     */
+    bool try_push(const sycl::sub_group &sg, const T &value, bool active = true) {
+        const sycl::ext::sub_group_mask_t<> mask = sycl::ext::ballot(sg, active);
+        const size_t rank = sycl::popcount(mask & ((sycl::ext::sub_group_mask_t<>{1} << sg.get_local_linear_id()) - 1u));
+        size_t granted = 0, first_ticket = 0;
+        if (sg.get_local_linear_id() == 0 && mask != 0) {
+            granted = reserve_push(sycl::popcount(mask));
+            first_ticket = take_tickets(tail_, granted);
+        }
+        granted = sycl::ext::broadcast_leader(sg, granted);
+        first_ticket = sycl::ext::broadcast_leader(sg, first_ticket);
+        if (!active || rank >= granted) return false;
+        write_ticket(first_ticket + rank, value);
+        return true;
+    }
+
+    /**
+     * Pops one value for each active work-items of the sub-group with a single reservation. Must be called by the whole sub-group.
+     * @return false if the queue was empty for this work-item
+     */
+    bool try_pop(const sycl::sub_group &sg, T &value, bool active = true) {
+        const sycl::ext::sub_group_mask_t<> mask = sycl::ext::ballot(sg, active);
+        const size_t rank = sycl::popcount(mask & ((sycl::ext::sub_group_mask_t<>{1} << sg.get_local_linear_id()) - 1u));
+        size_t granted = 0, first_ticket = 0;
+        if (sg.get_local_linear_id() == 0 && mask != 0) {
+            granted = reserve_pop(sycl::popcount(mask));
+            first_ticket = take_tickets(head_, granted);
+        }
+        granted = sycl::ext::broadcast_leader(sg, granted);
+        first_ticket = sycl::ext::broadcast_leader(sg, first_ticket);
+        if (!active || rank >= granted) return false;
+        value = read_ticket(first_ticket + rank);
+        return true;
+    }
+
+#endif
+};
@@ -25,6 +25,8 @@
 #include <sycl/sycl.hpp>
 #include <type_traits>
 #include <array>
+#include <utility>
+#include <cstdint>
 
 namespace sycl::ext {
     namespace registerizer_internal {
@@ -53,100 +55,126 @@ namespace sycl::ext {
     using has_subscript = can_apply<subscript_t, T, Index>;
 
 
+    /**
+     * How a runtime index is resolved over a registerized array of N elements:
+     *  - linear: N compare and selects, branch-free, the best choice when the index diverges between work-items;
+     *  - switch_case: a chain of compare and branches that the compiler lowers to a switch, lighter when all the
+     *    work-items of a sub-group use the same index;
+     *  - binary_search: log2(N) nested compare and branches, for large arrays accessed with uniform indices;
+     *  - stack: plain subscript, the array is left in addressable memory, for arrays too large for the registers;
+     *  - automatic: one of linear, binary_search or stack picked by select_registerizer_strategy.
+     */
+    enum class registerizer_strategy {
+        linear,
+        switch_case,
+        binary_search,
+        stack,
+        automatic
+    };
+
+/**
+ * Crossover table of the automatic strategy, in elements, with one column per element size of 1, 2, 4 and 8 bytes
+ * (larger elements use the 8 bytes column). Arrays up to SYCL_EXT_REGISTERIZER_LINEAR_MAX elements use the linear
+ * strategy, up to SYCL_EXT_REGISTERIZER_BINARY_SEARCH_MAX the binary search, and the stack beyond.
+ * No crossover has been measured yet, so the default stays in registers: linear up to 16 elements and binary search
+ * above, on every target. benchmark_registerizer_crossover measures the crossovers on a device and prints the
+ * definitions to use for it, which may also enable the stack fallback. Each macro can be defined on its own.
+ */
+#ifndef SYCL_EXT_REGISTERIZER_LINEAR_MAX
+#define SYCL_EXT_REGISTERIZER_LINEAR_MAX {16, 16, 16, 16}
+#endif
+
+#ifndef SYCL_EXT_REGISTERIZER_BINARY_SEARCH_MAX
+#define SYCL_EXT_REGISTERIZER_BINARY_SEARCH_MAX {SIZE_MAX, SIZE_MAX, SIZE_MAX, SIZE_MAX}
+#endif
+
     namespace registerizer_internal {
+        struct registerizer_crossovers {
+            size_t linear_max[4];
+            size_t binary_search_max[4];
+        };
 
+        constexpr registerizer_crossovers crossovers{SYCL_EXT_REGISTERIZER_LINEAR_MAX, SYCL_EXT_REGISTERIZER_BINARY_SEARCH_MAX};
 
-#ifdef RUNTIME_IDX_STORE_USE_SWITCH
-#define RUNTIME_IDX_STORE_SWITCH_CASE(id, arr, val)\
-        case (id): (arr)[(id)] = val; break;
-#else
-#define RUNTIME_IDX_STORE_SWITCH_CASE(id, arr, val)\
-    (arr)[(id)] = ((id)==(i)) ? (val) : (arr)[(id)] ;
+        static inline constexpr size_t crossover_column(const size_t &element_size) {
+            return element_size <= 1 ? 0 : element_size <= 2 ? 1 : element_size <= 4 ? 2 : 3;
+        }
+    }
 
-#endif
+    /**
+     * Strategy used by registerizer_strategy::automatic for an array of N elements of type T on the target being
+     * compiled for.
+     */
+    template<typename T, size_t N>
+    static inline constexpr registerizer_strategy select_registerizer_strategy() {
+        constexpr size_t column = registerizer_internal::crossover_column(sizeof(T));
+        if constexpr (N <= registerizer_internal::crossovers.linear_max[column]) {
+            return registerizer_strategy::linear;
+        } else if constexpr (N <= registerizer_internal::crossovers.binary_search_max[column]) {
+            return registerizer_strategy::binary_search;
+        } else {
+            return registerizer_strategy::stack;
+        }
+    }
 
-#define RUNTIME_IDX_STORE_SWITCH_1_CASE(arr, val) RUNTIME_IDX_STORE_SWITCH_CASE(0u, arr, val)
-#define RUNTIME_IDX_STORE_SWITCH_2_CASES(arr, val) RUNTIME_IDX_STORE_SWITCH_1_CASE(arr, val) RUNTIME_IDX_STORE_SWITCH_CASE(1u, arr, val)
-#define RUNTIME_IDX_STORE_SWITCH_3_CASES(arr, val) RUNTIME_IDX_STORE_SWITCH_2_CASES(arr, val) RUNTIME_IDX_STORE_SWITCH_CASE(2u, arr, val)
-#define RUNTIME_IDX_STORE_SWITCH_4_CASES(arr, val) RUNTIME_IDX_STORE_SWITCH_3_CASES(arr, val) RUNTIME_IDX_STORE_SWITCH_CASE(3u, arr, val)
-#define RUNTIME_IDX_STORE_SWITCH_5_CASES(arr, val) RUNTIME_IDX_STORE_SWITCH_4_CASES(arr, val) RUNTIME_IDX_STORE_SWITCH_CASE(4u, arr, val)
-#define RUNTIME_IDX_STORE_SWITCH_6_CASES(arr, val) RUNTIME_IDX_STORE_SWITCH_5_CASES(arr, val) RUNTIME_IDX_STORE_SWITCH_CASE(5u, arr, val)
-#define RUNTIME_IDX_STORE_SWITCH_7_CASES(arr, val) RUNTIME_IDX_STORE_SWITCH_6_CASES(arr, val) RUNTIME_IDX_STORE_SWITCH_CASE(6u, arr, val)
-#define RUNTIME_IDX_STORE_SWITCH_8_CASES(arr, val) RUNTIME_IDX_STORE_SWITCH_7_CASES(arr, val) RUNTIME_IDX_STORE_SWITCH_CASE(7u, arr, val)
-#define RUNTIME_IDX_STORE_SWITCH_9_CASES(arr, val) RUNTIME_IDX_STORE_SWITCH_8_CASES(arr, val) RUNTIME_IDX_STORE_SWITCH_CASE(8u, arr, val)
-#define RUNTIME_IDX_STORE_SWITCH_10_CASES(arr, val) RUNTIME_IDX_STORE_SWITCH_9_CASES(arr, val) RUNTIME_IDX_STORE_SWITCH_CASE(9u, arr, val)
-#define RUNTIME_IDX_STORE_SWITCH_11_CASES(arr, val) RUNTIME_IDX_STORE_SWITCH_10_CASES(arr, val) RUNTIME_IDX_STORE_SWITCH_CASE(10u, arr, val)
-#define RUNTIME_IDX_STORE_SWITCH_12_CASES(arr, val) RUNTIME_IDX_STORE_SWITCH_11_CASES(arr, val) RUNTIME_IDX_STORE_SWITCH_CASE(11u, arr, val)
-#define RUNTIME_IDX_STORE_SWITCH_13_CASES(arr, val) RUNTIME_IDX_STORE_SWITCH_12_CASES(arr, val) RUNTIME_IDX_STORE_SWITCH_CASE(12u, arr, val)
-#define RUNTIME_IDX_STORE_SWITCH_14_CASES(arr, val) RUNTIME_IDX_STORE_SWITCH_13_CASES(arr, val) RUNTIME_IDX_STORE_SWITCH_CASE(13u, arr, val)
-#define RUNTIME_IDX_STORE_SWITCH_15_CASES(arr, val) RUNTIME_IDX_STORE_SWITCH_14_CASES(arr, val) RUNTIME_IDX_STORE_SWITCH_CASE(14u, arr, val)
-#define RUNTIME_IDX_STORE_SWITCH_16_CASES(arr, val) RUNTIME_IDX_STORE_SWITCH_15_CASES(arr, val) RUNTIME_IDX_STORE_SWITCH_CASE(15u, arr, val)
-#ifdef RUNTIME_IDX_STORE_USE_SWITCH
-#define GENERATE_IDX_STORE(ID, arr, idx, val)            \
-switch(idx){                                            \
-    RUNTIME_IDX_STORE_SWITCH_##ID##_CASES(arr, val)     \
-      default:                                          \
-        (arr)[0] = val;                                 \
-}
-#else
-#define GENERATE_IDX_STORE(ID, arr, idx, val)            \
-{                                                       \
-    RUNTIME_IDX_STORE_SWITCH_##ID##_CASES(arr, val)     \
-}
-#endif
+    /**
+     * select_registerizer_strategy without the stack fallback, for the containers that must stay in registers: an
+     * array addressed once with a dynamic index is addressable, so all its other accesses would spill too.
+     */
+    template<typename T, size_t N>
+    static inline constexpr registerizer_strategy select_register_only_strategy() {
+        constexpr registerizer_strategy strategy = select_registerizer_strategy<T, N>();
+        return strategy == registerizer_strategy::stack ? registerizer_strategy::binary_search : strategy;
+    }
+
+    namespace registerizer_internal {
 
-        template<typename T, typename array_t, int N, int idx_max = N - 1>
+        template<typename T, typename array_t, size_t start, size_t end>
+        static inline constexpr void registerized_binary_store(array_t &arr, const uint &i, const T &val) noexcept {
+            if constexpr (start == end) {
+                if (i == start) arr[start] = val;
+            } else {
+                constexpr size_t middle = (start + end) / 2;
+                if (i <= middle) {
+                    registerized_binary_store<T, array_t, start, middle>(arr, i, val);
+                } else {
+                    registerized_binary_store<T, array_t, middle + 1, end>(arr, i, val);
+                }
+            }
+        }
+
+        template<registerizer_strategy strategy, typename T, typename array_t, size_t... I>
+        static inline constexpr void registerized_store_impl(array_t &arr, const uint &i, const T &val, std::index_sequence<I...>) noexcept {
+            if constexpr (strategy == registerizer_strategy::linear) {
+                ((arr[I] = (I == i) ? val : arr[I]), ...);
+            } else if constexpr (strategy == registerizer_strategy::switch_case) {
+                (void) (((I == i) ? (arr[I] = val, true) : false) || ...);
+            } else {
+                registerized_binary_store<T, array_t, 0, sizeof...(I) - 1>(arr, i, val);
+            }
+        }
+
+        /**
+         * Stores val at the runtime index i of an array of N elements, out of range indices are ignored.
+         */
+        template<registerizer_strategy strategy, typename T, typename array_t, size_t N>
         static inline constexpr void registerized_store(array_t &arr, const uint &i, const T &val) noexcept {
-            static_assert(idx_max >= 0 && idx_max < N);
+            static_assert(N > 0);
 #ifdef CONSTEVAL_REGISTER_SHORTCUT
             if (__builtin_is_constant_evaluated()) {
                 arr[i] = val;
                 return;
             }
 #endif
-            if constexpr (idx_max == 0 || N == 1) {
-                arr[0] = val;
-            } else if constexpr (N == 2) {
-                GENERATE_IDX_STORE(2, arr, i, val)
-            } else if constexpr (N == 3) {
-                GENERATE_IDX_STORE(3, arr, i, val)
-            } else if constexpr (N == 4) {
-                GENERATE_IDX_STORE(4, arr, i, val)
-            } else if constexpr (N == 5) {
-                GENERATE_IDX_STORE(5, arr, i, val)
-            } else if constexpr (N == 6) {
-                GENERATE_IDX_STORE(6, arr, i, val)
-            } else if constexpr (N == 7) {
-                GENERATE_IDX_STORE(7, arr, i, val)
-            } else if constexpr (N == 8) {
-                GENERATE_IDX_STORE(8, arr, i, val)
-            } else if constexpr (N == 9) {
-                GENERATE_IDX_STORE(9, arr, i, val)
-            } else if constexpr (N == 10) {
-                GENERATE_IDX_STORE(10, arr, i, val)
-            } else if constexpr (N == 11) {
-                GENERATE_IDX_STORE(11, arr, i, val)
-            } else if constexpr (N == 12) {
-                GENERATE_IDX_STORE(12, arr, i, val)
-            } else if constexpr (N == 13) {
-                GENERATE_IDX_STORE(13, arr, i, val)
-            } else if constexpr (N == 14) {
-                GENERATE_IDX_STORE(14, arr, i, val)
-            } else if constexpr (N == 15) {
-                GENERATE_IDX_STORE(15, arr, i, val)
-            } else if constexpr (N == 16 || idx_max == 15) { // End of recursion if we started with N>16
-                GENERATE_IDX_STORE(16, arr, i, val)
+            if constexpr (strategy == registerizer_strategy::automatic) {
+                registerized_store<select_registerizer_strategy<T, N>(), T, array_t, N>(arr, i, val);
+            } else if constexpr (strategy == registerizer_strategy::stack) {
+                if (i < N) arr[i] = val;
             } else {
-                if (i != idx_max) {
-                    registerized_store<T, array_t, N, idx_max - 1>(arr, i, val);
-                } else {
-                    arr[idx_max] = val;
-                }
+                registerized_store_impl<strategy, T>(arr, i, val, std::make_index_sequence<N>{});
             }
         }
 
-#undef GENERATE_IDX_STORE
-
         template<typename func, typename T, typename array_t, int N, int idx_max = N - 1>
         static inline constexpr void registerized_const_forall(const array_t &arr, const func &&f) noexcept {
             static_assert(idx_max >= 0 && idx_max < N);
@@ -173,24 +201,15 @@ switch(idx){                                            \
         }
 
 
-        template<typename T, typename array_t, int N, int idx_max = N - 1>
-        [[nodiscard]] static inline constexpr T registerized_read(const array_t &arr, const uint &idx) noexcept {
-            static_assert(idx_max >= 0 && idx_max < N);
-
-#ifdef CONSTEVAL_REGISTER_SHORTCUT
-            if (__builtin_is_constant_evaluated()) {
-                return arr[idx];
-            }
-#endif
-            if constexpr (idx_max == 0 || N == 1) {
-                return arr[0];
+        template<registerizer_strategy strategy, typename T, typename array_t, size_t... I>
+        [[nodiscard]] static inline constexpr T registerized_read_impl(const array_t &arr, const uint &idx, std::index_sequence<I...>) noexcept {
+            T out = arr[0];
+            if constexpr (strategy == registerizer_strategy::linear) {
+                ((out = (I == idx) ? arr[I] : out), ...);
             } else {
-                if (idx == idx_max) {
-                    return arr[idx_max];
-                } else {
-                    return registerized_read<T, array_t, N, idx_max - 1>(arr, idx);
-                }
+                (void) (((I == idx) ? (out = arr[I], true) : false) || ...);
             }
+            return out;
         }
 
         template<typename T, typename array_t, size_t N, int start = 0, int end = N - 1>
@@ -223,25 +242,173 @@ switch(idx){                                            \
                 }
             }
         }
+
+        /**
+         * Reads the runtime index idx of an array of N elements, out of range indices read the first element with
+         * every strategy but binary_search.
+         */
+        template<registerizer_strategy strategy, typename T, typename array_t, size_t N>
+        [[nodiscard]] static inline constexpr T registerized_read(const array_t &arr, const uint &idx) noexcept {
+            static_assert(N > 0);
+#ifdef CONSTEVAL_REGISTER_SHORTCUT
+            if (__builtin_is_constant_evaluated()) {
+                return arr[idx];
+            }
+#endif
+            if constexpr (strategy == registerizer_strategy::automatic) {
+                return registerized_read<select_registerizer_strategy<T, N>(), T, array_t, N>(arr, idx);
+            } else if constexpr (strategy == registerizer_strategy::stack) {
+                return idx < N ? arr[idx] : arr[0];
+            } else if constexpr (strategy == registerizer_strategy::binary_search) {
+                return registerized_dicochotomic_read<T, array_t, N>(arr, idx);
+            } else {
+                return registerized_read_impl<strategy, T>(arr, idx, std::make_index_sequence<N>{});
+            }
+        }
+
+        template<typename T, typename array_t, size_t K, size_t... I>
+        [[nodiscard]] static inline constexpr std::array<T, K> registerized_gather_impl(const array_t &arr, const std::array<uint, K> &idx, std::index_sequence<I...>) noexcept {
+            std::array<T, K> out{};
+            for (size_t k = 0; k < K; ++k) {
+                out[k] = arr[0];
+            }
+            auto select = [&](const size_t &i, const T &value) {
+#pragma unroll
+                for (size_t k = 0; k < K; ++k) {
+                    out[k] = (idx[k] == i) ? value : out[k];
+                }
+            };
+            (select(I, arr[I]), ...);
+            return out;
+        }
+
+        /**
+         * Reads the K runtime indices of idx in a single pass over an array of N elements: each element is read once
+         * and compared against all the indices. Out of range indices read the first element.
+         */
+        template<typename T, typename array_t, size_t N, size_t K>
+        [[nodiscard]] static inline constexpr std::array<T, K> registerized_gather(const array_t &arr, const std::array<uint, K> &idx) noexcept {
+            static_assert(N > 0);
+#ifdef CONSTEVAL_REGISTER_SHORTCUT
+            if (__builtin_is_constant_evaluated()) {
+                std::array<T, K> out{};
+                for (size_t k = 0; k < K; ++k) {
+                    out[k] = idx[k] < N ? arr[idx[k]] : arr[0];
+                }
+                return out;
+            }
+#endif
+            return registerized_gather_impl<T, array_t, K>(arr, idx, std::make_index_sequence<N>{});
+        }
+
+        template<typename T, typename array_t, size_t K, size_t... I>
+        static inline constexpr void registerized_scatter_impl(array_t &arr, const std::array<uint, K> &idx, const std::array<T, K> &values, std::index_sequence<I...>) noexcept {
+            auto merge = [&](const size_t &i, T value) {
+#pragma unroll
+                for (size_t k = 0; k < K; ++k) {
+                    value = (idx[k] == i) ? values[k] : value;
+                }
+                return value;
+            };
+            ((arr[I] = merge(I, arr[I])), ...);
+        }
+
+        /**
+         * Writes values[k] at the runtime index idx[k] in a single pass over an array of N elements: each element is
+         * written once. When several indices are equal, the last one wins. Out of range indices are ignored.
+         */
+        template<typename T, typename array_t, size_t N, size_t K>
+        static inline constexpr void registerized_scatter(array_t &arr, const std::array<uint, K> &idx, const std::array<T, K> &values) noexcept {
+            static_assert(N > 0);
+#ifdef CONSTEVAL_REGISTER_SHORTCUT
+            if (__builtin_is_constant_evaluated()) {
+                for (size_t k = 0; k < K; ++k) {
+                    if (idx[k] < N) arr[idx[k]] = values[k];
+                }
+                return;
+            }
+#endif
+            registerized_scatter_impl<T, array_t, K>(arr, idx, values, std::make_index_sequence<N>{});
+        }
+
+        /**
+         * Rows, columns and element type of the 2D arrays std::array<std::array<T, C>, R> and T[R][C]
+         */
+        template<typename array_t>
+        struct array_2d_traits;
+
+        template<typename T, size_t C, size_t R>
+        struct array_2d_traits<std::array<std::array<T, C>, R>> {
+            using value_type = T;
+            static constexpr size_t rows = R;
+            static constexpr size_t cols = C;
+        };
+
+        template<typename T, size_t R, size_t C>
+        struct array_2d_traits<T[R][C]> {
+            using value_type = T;
+            static constexpr size_t rows = R;
+            static constexpr size_t cols = C;
+        };
+
+        /**
+         * Row-major view of a 2D array as R * C elements. The 1D strategies only subscript it with constants, that
+         * resolve to constant row and column indices once unrolled.
+         */
+        template<size_t C, typename array_t>
+        struct flat_2d_view {
+            array_t &arr;
+
+            constexpr auto &operator[](const size_t &i) const { return arr[i / C][i % C]; }
+        };
+
+        /**
+         * View of the column col of a 2D array
+         */
+        template<size_t col, typename array_t>
+        struct column_view {
+            array_t &arr;
+
+            constexpr auto &operator[](const size_t &i) const { return arr[i][col]; }
+        };
+
+        /**
+         * Row-major index of (row, col) for a store, R * C when out of range so that a column overflow cannot alias the
+         * next row and the store is ignored
+         */
+        template<size_t R, size_t C>
+        static inline constexpr uint flat_2d_index(const uint &row, const uint &col) noexcept {
+            return (row < R && col < C) ? (uint) (row * C + col) : (uint) (R * C);
+        }
+
+        /**
+         * Row-major index of (row, col) for a read, 0 when out of range: the binary search would read the last element
+         * of an out of range index, this makes every strategy read (0, 0)
+         */
+        template<size_t R, size_t C>
+        static inline constexpr uint flat_2d_read_index(const uint &row, const uint &col) noexcept {
+            return (row < R && col < C) ? (uint) (row * C + col) : 0u;
+        }
     }
 
 
 /**
- * Subscript operators
+ * Subscript operators. The strategy template parameter selects how the runtime index is resolved, see
+ * registerizer_strategy, and the _log variants use the binary search.
  */
-    template<int idx_max, typename func, typename T = std::remove_reference_t<subscript_t<func, int>>, typename U>
+    template<int idx_max, registerizer_strategy strategy = registerizer_strategy::linear, typename func, typename T = std::remove_reference_t<subscript_t<func, int>>, typename U>
     static inline constexpr U runtime_index_wrapper(func &f, const uint &i, const U &val) {
         static_assert(has_subscript<func, int>::value, "Must have an int subscript operator");
         static_assert(!std::is_array_v<func>, "Not for arrays");
-        registerizer_internal::registerized_store<T, func, idx_max>(f, i, (T) val);
+        registerizer_internal::registerized_store<strategy, T, func, idx_max>(f, i, (T) val);
         return val;
     }
 
-    template<int idx_max, typename func, typename T = std::remove_reference_t<subscript_t<func, int>>>
+    template<int idx_max, registerizer_strategy strategy = registerizer_strategy::linear, typename func, typename T = std::remove_reference_t<subscript_t<func, int>>>
     [[nodiscard]] static inline constexpr T runtime_index_wrapper(const func &f, const uint &i) {
         static_assert(has_subscript<func, int>::value, "Must have an int subscript operator");
         static_assert(!std::is_array_v<func>, "Not for arrays");
-        return registerizer_internal::registerized_read<T, func, idx_max>(f, i);
+        return registerizer_internal::registerized_read<strategy, T, func, idx_max>(f, i);
     }
 
 
@@ -249,46 +416,46 @@ switch(idx){                                            \
     [[nodiscard]] static inline constexpr T runtime_index_wrapper_log(const func &f, const uint &i) {
         static_assert(has_subscript<func, int>::value, "Must have an int subscript operator");
         static_assert(!std::is_array_v<func>, "Not for arrays");
-        return registerizer_internal::registerized_dicochotomic_read<T, func, idx_max>(f, i);
+        return registerizer_internal::registerized_read<registerizer_strategy::binary_search, T, func, idx_max>(f, i);
     }
 
 
 /**
  * C-Style arrays
  */
-    template<typename T, int N, typename U>
+    template<registerizer_strategy strategy = registerizer_strategy::linear, typename T, int N, typename U>
     static inline constexpr U runtime_index_wrapper(T (&arr)[N], const uint i, const U &val) {
-        registerizer_internal::registerized_store<T, T (&)[N], N>(arr, i, (std::remove_reference_t<T>) val);
+        registerizer_internal::registerized_store<strategy, T, T (&)[N], N>(arr, i, (std::remove_reference_t<T>) val);
         return val;
     }
 
-    template<typename T, int N>
+    template<registerizer_strategy strategy = registerizer_strategy::linear, typename T, int N>
     [[nodiscard]] static inline constexpr T runtime_index_wrapper(const T (&arr)[N], const uint &i) {
-        return registerizer_internal::registerized_read<T, const T (&)[N], N>(arr, i);
+        return registerizer_internal::registerized_read<strategy, T, const T (&)[N], N>(arr, i);
     }
 
     template<typename T, int N>
     [[nodiscard]] static inline constexpr T runtime_index_wrapper_log(const T (&arr)[N], const uint &i) {
-        return registerizer_internal::registerized_dicochotomic_read<T, const T(&)[N], N>(arr, i);
+        return registerizer_internal::registerized_read<registerizer_strategy::binary_search, T, const T (&)[N], N>(arr, i);
     }
 
 /**
  * STD::ARRAY
  */
-    template<typename T, size_t N, typename U>
+    template<registerizer_strategy strategy = registerizer_strategy::linear, typename T, size_t N, typename U>
     static inline constexpr U runtime_index_wrapper(std::array<T, N> &array, const uint &i, const U &val) {
-        registerizer_internal::registerized_store<T, std::array<T, N>, N>(array, i, (T) val);
+        registerizer_internal::registerized_store<strategy, T, std::array<T, N>, N>(array, i, (T) val);
         return val;
     }
 
-    template<typename T, size_t N>
+    template<registerizer_strategy strategy = registerizer_strategy::linear, typename T, size_t N>
     [[nodiscard]] static inline constexpr T runtime_index_wrapper(const std::array<T, N> &array, const uint &i) {
-        return registerizer_internal::registerized_read<T, std::array<T, N>, N>(array, i);
+        return registerizer_internal::registerized_read<strategy, T, std::array<T, N>, N>(array, i);
     }
 
     template<typename T, size_t N>
     [[nodiscard]] static inline constexpr T runtime_index_wrapper_log(const std::array<T, N> &array, const uint &i) {
-        return registerizer_internal::registerized_dicochotomic_read<T, std::array<T, N>, N>(array, i);
+        return registerizer_internal::registerized_read<registerizer_strategy::binary_search, T, std::array<T, N>, N>(array, i);
     }
 
     template<typename func, typename T, size_t N>
@@ -305,46 +472,155 @@ switch(idx){                                            \
 /**
  * SYCL VEC
  */
-    template<typename T, auto N, typename U>
+    template<registerizer_strategy strategy = registerizer_strategy::linear, typename T, auto N, typename U>
     static inline constexpr U runtime_index_wrapper(sycl::vec<T, N> &vec, const uint &i, const U &val) {
-        registerizer_internal::registerized_store<T, sycl::vec<T, N>, N>(vec, i, val);
+        registerizer_internal::registerized_store<strategy, T, sycl::vec<T, N>, N>(vec, i, val);
         return val;
     }
 
-    template<typename T, auto N>
+    template<registerizer_strategy strategy = registerizer_strategy::linear, typename T, auto N>
     [[nodiscard]] static inline constexpr T runtime_index_wrapper(const sycl::vec<T, N> &vec, const uint &i) {
-        return registerizer_internal::registerized_read<T, sycl::vec<T, N>, N>(vec, i);
+        return registerizer_internal::registerized_read<strategy, T, sycl::vec<T, N>, N>(vec, i);
     }
 
     template<typename T, auto N>
     [[nodiscard]] static inline constexpr T runtime_index_wrapper_log(const sycl::vec<T, N> &vec, const uint &i) {
-        return registerizer_internal::registerized_dicochotomic_read<T, sycl::vec<T, N>, N>(vec, i);
+        return registerizer_internal::registerized_read<registerizer_strategy::binary_search, T, sycl::vec<T, N>, N>(vec, i);
     }
 
 /**
  * SYCL ID
  */
-    template<template<int> class vec_t, int N, typename U>
+    template<registerizer_strategy strategy = registerizer_strategy::linear, template<int> class vec_t, int N, typename U>
     static inline constexpr U runtime_index_wrapper(vec_t<N> &vec, const uint &i, const U &val) {
-        registerizer_internal::registerized_store<size_t, vec_t<N>, N>(vec, i, (uint) val);
+        registerizer_internal::registerized_store<strategy, size_t, vec_t<N>, N>(vec, i, (uint) val);
         return val;
     }
 
-    template<template<int> class vec_t, int N>
+    template<registerizer_strategy strategy = registerizer_strategy::linear, template<int> class vec_t, int N>
     [[nodiscard]] static inline constexpr size_t runtime_index_wrapper(const vec_t<N> &vec, const uint &i) {
-        return registerizer_internal::registerized_read<size_t, vec_t<N>, N>(vec, i);
+        return registerizer_internal::registerized_read<strategy, size_t, vec_t<N>, N>(vec, i);
     }
 
 
     template<template<int> class vec_t, int N>
     [[nodiscard]]  static inline constexpr size_t runtime_index_wrapper_log(const vec_t<N> &vec, const uint &i) {
-        return registerizer_internal::registerized_dicochotomic_read<size_t, vec_t<N>, N>(vec, i);
+        return registerizer_internal::registerized_read<registerizer_strategy::binary_search, size_t, vec_t<N>, N>(vec, i);
+    }
+
+/**
+ * Gather and scatter of K runtime indices at once. The array is walked once for all the indices instead of once per
+ * index, which saves the repeated moves and stores of the per-index accesses.
+ */
+    template<typename T, size_t N, size_t K>
+    [[nodiscard]] static inline constexpr std::array<T, K> runtime_gather(const std::array<T, N> &array, const std::array<uint, K> &idx) {
+        return registerizer_internal::registerized_gather<T, std::array<T, N>, N, K>(array, idx);
+    }
+
+    template<typename T, int N, size_t K>
+    [[nodiscard]] static inline constexpr std::array<T, K> runtime_gather(const T (&arr)[N], const std::array<uint, K> &idx) {
+        return registerizer_internal::registerized_gather<T, const T (&)[N], N, K>(arr, idx);
+    }
+
+    template<typename T, auto N, size_t K>
+    [[nodiscard]] static inline constexpr std::array<T, K> runtime_gather(const sycl::vec<T, N> &vec, const std::array<uint, K> &idx) {
+        return registerizer_internal::registerized_gather<T, sycl::vec<T, N>, N, K>(vec, idx);
+    }
+
+    /**
+     * runtime_gather(arr, idx0, idx1, ...) returns {arr[idx0], arr[idx1], ...}
+     */
+    template<typename array_t, typename... Idx>
+    [[nodiscard]] static inline constexpr auto runtime_gather(const array_t &arr, const Idx &... idx)
+    -> std::enable_if_t<(std::is_integral_v<Idx> && ...), decltype(runtime_gather(arr, std::array<uint, sizeof...(Idx)>{}))> {
+        return runtime_gather(arr, std::array<uint, sizeof...(Idx)>{static_cast<uint>(idx)...});
+    }
+
+    template<typename T, size_t N, size_t K, typename U>
+    static inline constexpr void runtime_scatter(std::array<T, N> &array, const std::array<uint, K> &idx, const std::array<U, K> &values) {
+        std::array<T, K> converted{};
+        for (size_t k = 0; k < K; ++k) converted[k] = (T) values[k];
+        registerizer_internal::registerized_scatter<T, std::array<T, N>, N, K>(array, idx, converted);
+    }
+
+    template<typename T, int N, size_t K, typename U>
+    static inline constexpr void runtime_scatter(T (&arr)[N], const std::array<uint, K> &idx, const std::array<U, K> &values) {
+        std::array<T, K> converted{};
+        for (size_t k = 0; k < K; ++k) converted[k] = (T) values[k];
+        registerizer_internal::registerized_scatter<T, T (&)[N], N, K>(arr, idx, converted);
+    }
+
+    template<typename T, auto N, size_t K, typename U>
+    static inline constexpr void runtime_scatter(sycl::vec<T, N> &vec, const std::array<uint, K> &idx, const std::array<U, K> &values) {
+        std::array<T, K> converted{};
+        for (size_t k = 0; k < K; ++k) converted[k] = (T) values[k];
+        registerizer_internal::registerized_scatter<T, sycl::vec<T, N>, N, K>(vec, idx, converted);
+    }
+
+/**
+ * 2D arrays, std::array<std::array<T, C>, R> and T[R][C], with a runtime row and column. Both dimensions are
+ * registerized: the array is resolved as R * C row-major elements with the strategy, out of range pairs read the
+ * element (0, 0) and are ignored by the stores.
+ */
+    template<registerizer_strategy strategy = registerizer_strategy::linear, typename array_t, typename traits = registerizer_internal::array_2d_traits<array_t>>
+    [[nodiscard]] static inline constexpr typename traits::value_type runtime_index_wrapper_2d(const array_t &arr, const uint &row, const uint &col) {
+        using view_t = registerizer_internal::flat_2d_view<traits::cols, const array_t>;
+        return registerizer_internal::registerized_read<strategy, typename traits::value_type, view_t, traits::rows * traits::cols>(
+                view_t{arr}, registerizer_internal::flat_2d_read_index<traits::rows, traits::cols>(row, col));
+    }
+
+    template<registerizer_strategy strategy = registerizer_strategy::linear, typename array_t, typename U, typename traits = registerizer_internal::array_2d_traits<array_t>>
+    static inline constexpr U runtime_index_wrapper_2d(array_t &arr, const uint &row, const uint &col, const U &val) {
+        using T = typename traits::value_type;
+        registerizer_internal::flat_2d_view<traits::cols, array_t> view{arr};
+        registerizer_internal::registerized_store<strategy, T, decltype(view), traits::rows * traits::cols>(
+                view, registerizer_internal::flat_2d_index<traits::rows, traits::cols>(row, col), (T) val);
+        return val;
+    }
+
+    /**
+     * Runtime row in the compile-time column col: only the R elements of the column are looked at
+     */
+    template<size_t col, registerizer_strategy strategy = registerizer_strategy::linear, typename array_t, typename traits = registerizer_internal::array_2d_traits<array_t>>
+    [[nodiscard]] static inline constexpr typename traits::value_type runtime_index_wrapper_2d_fixed_col(const array_t &arr, const uint &row) {
+        static_assert(col < traits::cols);
+        using view_t = registerizer_internal::column_view<col, const array_t>;
+        return registerizer_internal::registerized_read<strategy, typename traits::value_type, view_t, traits::rows>(view_t{arr}, row);
+    }
+
+    template<size_t col, registerizer_strategy strategy = registerizer_strategy::linear, typename array_t, typename U, typename traits = registerizer_internal::array_2d_traits<array_t>>
+    static inline constexpr U runtime_index_wrapper_2d_fixed_col(array_t &arr, const uint &row, const U &val) {
+        static_assert(col < traits::cols);
+        using T = typename traits::value_type;
+        registerizer_internal::column_view<col, array_t> view{arr};
+        registerizer_internal::registerized_store<strategy, T, decltype(view), traits::rows>(view, row, (T) val);
+        return val;
+    }
+
+    /**
+     * Runtime column in the compile-time row row: only the C elements of the row are looked at
+     */
+    template<size_t row, registerizer_strategy strategy = registerizer_strategy::linear, typename array_t, typename traits = registerizer_internal::array_2d_traits<array_t>>
+    [[nodiscard]] static inline constexpr typename traits::value_type runtime_index_wrapper_2d_fixed_row(const array_t &arr, const uint &col) {
+        static_assert(row < traits::rows);
+        using row_t = std::remove_reference_t<decltype(arr[row])>;
+        return registerizer_internal::registerized_read<strategy, typename traits::value_type, row_t, traits::cols>(arr[row], col);
+    }
+
+    template<size_t row, registerizer_strategy strategy = registerizer_strategy::linear, typename array_t, typename U, typename traits = registerizer_internal::array_2d_traits<array_t>>
+    static inline constexpr U runtime_index_wrapper_2d_fixed_row(array_t &arr, const uint &col, const U &val) {
+        static_assert(row < traits::rows);
+        using T = typename traits::value_type;
+        using row_t = std::remove_reference_t<decltype(arr[row])>;
+        registerizer_internal::registerized_store<strategy, T, row_t, traits::cols>(arr[row], col, (T) val);
+        return val;
     }
 
 /**
  * Constructs an accessor that can be used with dynnamic indices at runtime
+ * @tparam strategy how the runtime indices are resolved, see registerizer_strategy
  */
-    template<class array_t>
+    template<class array_t, registerizer_strategy strategy = registerizer_strategy::linear>
     class runtime_wrapper {
     private:
         array_t &array_ref_;
@@ -357,7 +633,7 @@ switch(idx){                                            \
          * @return Value read
          */
         [[nodiscard]] auto read(uint i) const {
-            return runtime_index_wrapper(array_ref_, i);
+            return runtime_index_wrapper<strategy>(array_ref_, i);
         }
 
         [[nodiscard]] auto operator[](uint i) const {
@@ -373,7 +649,7 @@ switch(idx){                                            \
          */
         template<typename U>
         U write(uint i, const U &val) {
-            return runtime_index_wrapper(array_ref_, i, val);
+            return runtime_index_wrapper<strategy>(array_ref_, i, val);
         }
 
 
@@ -385,7 +661,7 @@ switch(idx){                                            \
          */
         template<int N>
         [[nodiscard]] auto read(uint i) const {
-            return runtime_index_wrapper<N>(array_ref_, i);
+            return runtime_index_wrapper<N, strategy>(array_ref_, i);
         }
 
         template<int N>
@@ -404,9 +680,117 @@ switch(idx){                                            \
          */
         template<int N, typename U>
         U write(uint i, const U &val) {
-            return runtime_index_wrapper<N>(array_ref_, i, val);
+            return runtime_index_wrapper<N, strategy>(array_ref_, i, val);
+        }
+
+        /**
+         * Reads K runtime indices in a single pass, for arrays/types with deduced size
+         */
+        template<size_t K>
+        [[nodiscard]] auto gather(const std::array<uint, K> &idx) const {
+            return runtime_gather(array_ref_, idx);
+        }
+
+        /**
+         * Writes K values at runtime indices in a single pass, for arrays/types with deduced size
+         */
+        template<size_t K, typename U>
+        void scatter(const std::array<uint, K> &idx, const std::array<U, K> &values) {
+            runtime_scatter(array_ref_, idx, values);
         }
     };
 
+    namespace registerizer_internal {
+        /**
+         * Accessor for the 2D arrays, with (row, col) indices and the fixed row and column fast paths
+         */
+        template<class array_t, registerizer_strategy strategy>
+        class runtime_wrapper_2d {
+        private:
+            array_t &array_ref_;
+        public:
+            [[nodiscard]] explicit runtime_wrapper_2d(array_t &arr) : array_ref_(arr) {}
+
+            /**
+             * Whole row accesses, as with the 1D runtime_wrapper, only for std::array rows
+             */
+            [[nodiscard]] auto read(uint row) const {
+                return runtime_index_wrapper<strategy>(array_ref_, row);
+            }
+
+            [[nodiscard]] auto operator[](uint row) const {
+                return read(row);
+            }
+
+            template<typename U>
+            U write(uint row, const U &val) {
+                return runtime_index_wrapper<strategy>(array_ref_, row, val);
+            }
+
+            [[nodiscard]] auto read(uint row, uint col) const {
+                return runtime_index_wrapper_2d<strategy>(array_ref_, row, col);
+            }
+
+            [[nodiscard]] auto operator()(uint row, uint col) const {
+                return read(row, col);
+            }
+
+            template<typename U>
+            U write(uint row, uint col, const U &val) {
+                return runtime_index_wrapper_2d<strategy>(array_ref_, row, col, val);
+            }
+
+            /**
+             * Runtime row in the compile-time column col
+             */
+            template<size_t col>
+            [[nodiscard]] auto read_fixed_col(uint row) const {
+                return runtime_index_wrapper_2d_fixed_col<col, strategy>(array_ref_, row);
+            }
+
+            template<size_t col, typename U>
+            U write_fixed_col(uint row, const U &val) {
+                return runtime_index_wrapper_2d_fixed_col<col, strategy>(array_ref_, row, val);
+            }
+
+            /**
+             * Runtime column in the compile-time row row
+             */
+            template<size_t row>
+            [[nodiscard]] auto read_fixed_row(uint col) const {
+                return runtime_index_wrapper_2d_fixed_row<row, strategy>(array_ref_, col);
+            }
+
+            template<size_t row, typename U>
+            U write_fixed_row(uint col, const U &val) {
+                return runtime_index_wrapper_2d_fixed_row<row, strategy>(array_ref_, col, val);
+            }
+        };
+    }
+
+    /**
+     * runtime_wrapper of the 2D arrays, indexed with (row, col)
+     */
+    template<typename T, size_t C, size_t R, registerizer_strategy strategy>
+    class runtime_wrapper<std::array<std::array<T, C>, R>, strategy> : public registerizer_internal::runtime_wrapper_2d<std::array<std::array<T, C>, R>, strategy> {
+    public:
+        using registerizer_internal::runtime_wrapper_2d<std::array<std::array<T, C>, R>, strategy>::runtime_wrapper_2d;
+    };
+
+    template<typename T, size_t R, size_t C, registerizer_strategy strategy>
+    class runtime_wrapper<T[R][C], strategy> : public registerizer_internal::runtime_wrapper_2d<T[R][C], strategy> {
+    public:
+        using registerizer_internal::runtime_wrapper_2d<T[R][C], strategy>::runtime_wrapper_2d;
+    };
+
+
+    /**
+     * Builds a runtime_wrapper with an explicit strategy, as in make_runtime_wrapper<registerizer_strategy::automatic>(arr)
+     */
+    template<registerizer_strategy strategy, class array_t>
+    [[nodiscard]] static inline runtime_wrapper<array_t, strategy> make_runtime_wrapper(array_t &arr) {
+        return runtime_wrapper<array_t, strategy>(arr);
+    }
+
 
 }
\ No newline at end of file
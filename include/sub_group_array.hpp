@@ -0,0 +1,136 @@
+/**
+    Copyright 2021 Codeplay Software Ltd.
+
+    Licensed under the Apache License, Version 2.0 (the "License");
+    you may not use these files except in compliance with the License.
+    You may obtain a copy of the License at
+
+    http://www.apache.org/licenses/LICENSE-2.0
+
+    For your convenience, a copy of the License has been included in this
+    repository.
+
+    Unless required by applicable law or agreed to in writing, software
+    distributed under the License is distributed on an "AS IS" BASIS,
+    WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+    See the License for the specific language governing permissions and
+    limitations under the License.
+ */
+
+#pragma once
+
+#include <sycl/sycl.hpp>
+#include <array>
+#include <cassert>
+#include <runtime_index_wrapper.hpp>
+
+namespace sycl::ext {
+
+    /**
+     * Array of N elements distributed over the registers of a sub-group: for a sub-group of S work-items, the element
+     * e is held by the lane e % S in its register slot e / S. Reads are served by shuffles, which gives the capacity of
+     * S times the per-lane registers with a register-speed access, instead of a local memory lookup table.
+     *
+     * Every member function must be called by the whole sub-group. The sub-group must be full and hold at least
+     * min_sub_group_size work-items, else the elements past slots * S are lost: load asserts it, see fits.
+     * @tparam min_sub_group_size sets the number of register slots per lane, ceil(N / min_sub_group_size). The default
+     * of 8 is the narrowest sub-group of the CUDA, Intel GPU and CPU devices. It holds the array on any of them, but
+     * wider sub-groups only use the first ceil(N / S) slots: a 32-wide sub-group keeps 4 times the registers it needs.
+     * Set it to the [[sycl::reqd_sub_group_size]] of the kernel to allocate only the slots that are used. It is not
+     * picked per compilation target because the host and device layouts of the class must match.
+     */
+    template<typename T, size_t N, size_t min_sub_group_size = 8>
+    class sub_group_array {
+    public:
+        static constexpr size_t slots = (N + min_sub_group_size - 1) / min_sub_group_size;
+
+        static_assert(N > 0 && min_sub_group_size > 0);
+
+        sub_group_array() = default;
+
+        /**
+         * Whether a sub-group of sub_group_size work-items holds the N elements
+         */
+        [[nodiscard]] static constexpr bool fits(const size_t &sub_group_size) {
+            return slots * sub_group_size >= N;
+        }
+
+        /**
+         * Coalesced load of the N elements starting at in
+         */
+        void load(const sycl::sub_group &sg, const T *in) {
+            const size_t lane = sg.get_local_linear_id();
+            const size_t size = sg.get_local_range().size();
+            assert(fits(size) && "sub_group_array: the sub-group is narrower than min_sub_group_size");
+#pragma unroll
+            for (size_t s = 0; s < slots && s * size < N; ++s) {
+                const size_t idx = s * size + lane;
+                if (idx < N) data_[s] = in[idx];
+            }
+        }
+
+        /**
+         * Coalesced store of the N elements to out
+         */
+        void store(const sycl::sub_group &sg, T *out) const {
+            const size_t lane = sg.get_local_linear_id();
+            const size_t size = sg.get_local_range().size();
+#pragma unroll
+            for (size_t s = 0; s < slots && s * size < N; ++s) {
+                const size_t idx = s * size + lane;
+                if (idx < N) out[idx] = data_[s];
+            }
+        }
+
+        /**
+         * Reads the element i, each work-item may read a different index. Costs one shuffle per register slot in use,
+         * ceil(N / S), whatever min_sub_group_size.
+         */
+        [[nodiscard]] T read(const sycl::sub_group &sg, const uint &i) const {
+            const uint size = sg.get_local_range().size();
+            const uint slot = i / size;
+            const uint lane = i % size;
+            T out = sycl::select_from_group(sg, data_[0], lane);
+#pragma unroll
+            for (uint s = 1; s < slots && s * size < N; ++s) { // Uniform bound, the slots past N are never shuffled
+                const T value = sycl::select_from_group(sg, data_[s], lane); // Every lane shuffles its slot s
+                out = (slot == s) ? value : out;
+            }
+            return out;
+        }
+
+        /**
+         * Reads the element i, that must be the same for the whole sub-group. Costs a register lookup and one broadcast.
+         */
+        [[nodiscard]] T read_uniform(const sycl::sub_group &sg, const uint &i) const {
+            const uint size = sg.get_local_range().size();
+            return sycl::group_broadcast(sg, runtime_index_wrapper(data_, i / size), i % size);
+        }
+
+        /**
+         * Writes val to the element i, i and val must be the same for the whole sub-group. Only the owning lane writes.
+         */
+        void write_uniform(const sycl::sub_group &sg, const uint &i, const T &val) {
+            const uint size = sg.get_local_range().size();
+            if (sg.get_local_linear_id() == i % size) {
+                runtime_index_wrapper(data_, i / size, val);
+            }
+        }
+
+        /**
+         * Register slot s of the calling lane, i.e. the element s * S + lane, for lane-local initialisation. s should be
+         * known at compile time to keep the slots in registers.
+         */
+        [[nodiscard]] T &local_slot(const size_t &s) {
+            return data_[s];
+        }
+
+        [[nodiscard]] const T &local_slot(const size_t &s) const {
+            return data_[s];
+        }
+
+    private:
+        std::array<T, slots> data_{};
+    };
+
+}
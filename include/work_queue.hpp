@@ -0,0 +1,142 @@
+/**
+    Copyright 2021 Codeplay Software Ltd.
+
+    Licensed under the Apache License, Version 2.0 (the "License");
+    you may not use these files except in compliance with the License.
+    You may obtain a copy of the License at
+
+    http://www.apache.org/licenses/LICENSE-2.0
+
+    For your convenience, a copy of the License has been included in this
+    repository.
+
+    Unless required by applicable law or agreed to in writing, software
+    distributed under the License is distributed on an "AS IS" BASIS,
+    WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+    See the License for the specific language governing permissions and
+    limitations under the License.
+ */
+
+#pragma once
+
+#include <sycl/sycl.hpp>
+#include <cassert>
+
+/**
+ * Ticket based work queue for persistent kernels: the groups of a grid sized with get_max_occupancy pull chunks of work
+ * from an atomic head until the queue is empty. Irregular work is balanced dynamically instead of being statically split.
+ */
+template<int dim = 1>
+class persistent_work_queue {
+private:
+    using atomic_ref_t = sycl::atomic_ref<
+            size_t,
+            sycl::memory_order::relaxed,
+            sycl::memory_scope::device,
+            sycl::access::address_space::global_space
+    >;
+
+    size_t head_ = 0;
+    size_t work_count_ = 0;
+
+    explicit persistent_work_queue(size_t work_count) : work_count_(work_count) {}
+
+    /**
+     * Index of the first offset that is not less than value, offsets must be sorted
+     */
+    static size_t lower_bound(const size_t *offsets, size_t count, const size_t &value) {
+        size_t first = 0;
+        while (count > 0) {
+            size_t step = count / 2;
+            if (offsets[first + step] < value) {
+                first += step + 1;
+                count -= step + 1;
+            } else {
+                count = step;
+            }
+        }
+        return first;
+    }
+
+public:
+
+    /**
+     * Constructor helper
+     * @param work_count number of work items (or total cost for weighted queues) to distribute
+     */
+    static persistent_work_queue<dim> *make_work_queue(sycl::queue &q, size_t work_count) {
+        auto work_queue = sycl::malloc_shared<persistent_work_queue<dim>>(1, q);
+        return new(work_queue) persistent_work_queue<dim>(work_count);
+    }
+
+    /**
+     * Re-arms the queue, must not be called while a kernel uses it.
+     */
+    void reset(size_t work_count) {
+        head_ = 0;
+        work_count_ = work_count;
+    }
+
+    [[nodiscard]] size_t size() const {
+        return work_count_;
+    }
+
+    /**
+     * Reserves count work items, can be called by any work-item.
+     * @return the index of the first work item reserved, greater or equal to size() if the queue is empty
+     */
+    size_t grab(const size_t &count) {
+        atomic_ref_t head_ref(head_);
+        return head_ref.fetch_add(count);
+    }
+
+    /**
+     * Calls f(begin, end) on all the work-items of the group for each chunk of chunk_size work items pulled by the group.
+     * Must be called by all the work-items of the group, chunk_size must not be 0.
+     */
+    template<typename func>
+    void for_each_chunk(const sycl::nd_item<dim> &item, const size_t &chunk_size, func &&f) {
+        assert(chunk_size > 0 && "grab(0) never empties the queue");
+        const auto group = item.get_group();
+        while (true) {
+            size_t begin = 0;
+            if (item.get_local_linear_id() == 0) {
+                begin = grab(chunk_size);
+            }
+            begin = sycl::group_broadcast(group, begin, 0);
+            if (begin >= work_count_) return;
+            f(begin, sycl::min(begin + chunk_size, work_count_));
+        }
+    }
+
+    /**
+     * Same as for_each_chunk, but work items have a variable cost. offsets holds the exclusive prefix sum of the costs, with
+     * size() + 1 elements. Each chunk covers about cost_per_chunk, a work item belongs to the chunk where its cost starts.
+     * The queue must be created with the total cost, offsets[size()]. If it is 0, all the items go to a single chunk.
+     * cost_per_chunk must not be 0.
+     */
+    template<typename func>
+    void for_each_weighted_chunk(const sycl::nd_item<dim> &item, const size_t *offsets, const size_t &item_count, const size_t &cost_per_chunk, func &&f) {
+        assert(cost_per_chunk > 0 && "grab(0) never empties the queue");
+        const auto group = item.get_group();
+        while (true) {
+            size_t begin = 0, end = 0;
+            bool done = false;
+            if (item.get_local_linear_id() == 0) {
+                const size_t lo = grab(cost_per_chunk);
+                done = lo >= sycl::max(work_count_, size_t{1}); // With a total cost of 0, the first chunk takes all the items
+                if (!done) {
+                    const size_t hi = lo + cost_per_chunk;
+                    begin = lower_bound(offsets, item_count, lo);
+                    end = hi >= work_count_ ? item_count : lower_bound(offsets, item_count, hi); // Trailing empty items go to the last chunk
+                }
+            }
+            if (sycl::group_broadcast(group, done, 0)) return;
+            begin = sycl::group_broadcast(group, begin, 0);
+            end = sycl::group_broadcast(group, end, 0);
+            if (begin < end) {
+                f(begin, end);
+            }
+        }
+    }
+};
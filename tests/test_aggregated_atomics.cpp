@@ -0,0 +1,54 @@
+#include <gtest/gtest.h>
+#include <aggregated_atomics.hpp>
+#include <usm_smart_ptr.hpp>
+#include <algorithm>
+#include <vector>
+
+using namespace usm_smart_ptr;
+
+constexpr size_t key_count = 5;
+
+/**
+ * Each work-item reserves value(id) slots in the bin id % key_count, the reserved ranges of a bin must tile it.
+ */
+void check_aggregated_atomics(sycl::queue q, size_t global_size) {
+    auto cursor = usm_unique_ptr<uint32_t, alloc::shared>(1, q);
+    auto bins = usm_unique_ptr<uint32_t, alloc::shared>(key_count, q);
+    auto cursor_offsets = usm_unique_ptr<uint32_t, alloc::shared>(global_size, q);
+    auto bin_offsets = usm_unique_ptr<uint32_t, alloc::shared>(global_size, q);
+    q.fill(cursor.get(), uint32_t(0), 1).wait();
+    q.fill(bins.get(), uint32_t(0), key_count).wait();
+    auto value = [](size_t id) { return uint32_t(id % 3 + 1); };
+
+    q.parallel_for<class aggregated_atomics_kernel>(sycl::nd_range<1>(global_size, 64), [=, cursor = cursor.get(), bins = bins.get(), cursor_offsets = cursor_offsets.get(), bin_offsets = bin_offsets.get()](sycl::nd_item<1> it) {
+        const size_t id = it.get_global_linear_id();
+        const auto sg = it.get_sub_group();
+        cursor_offsets[id] = sycl::ext::aggregated_atomic_add(sg, cursor, uint32_t(1));
+        bin_offsets[id] = sycl::ext::aggregated_atomic_add(sg, bins, id % key_count, value(id));
+    }).wait_and_throw();
+
+    ASSERT_EQ(*cursor.get(), global_size);
+    std::vector<uint32_t> sorted(cursor_offsets.get(), cursor_offsets.get() + global_size);
+    std::sort(sorted.begin(), sorted.end());
+    for (size_t i = 0; i < global_size; ++i) {
+        ASSERT_EQ(sorted[i], i);
+    }
+
+    for (size_t key = 0; key < key_count; ++key) {
+        std::vector<std::pair<uint32_t, uint32_t>> ranges;
+        for (size_t id = key; id < global_size; id += key_count) {
+            ranges.emplace_back(bin_offsets.get()[id], value(id));
+        }
+        std::sort(ranges.begin(), ranges.end());
+        uint32_t expected = 0;
+        for (const auto &[offset, size]: ranges) {
+            ASSERT_EQ(offset, expected);
+            expected += size;
+        }
+        ASSERT_EQ(bins.get()[key], expected);
+    }
+}
+
+TEST(aggregated_atomics, add) {
+    check_aggregated_atomics(sycl::queue{sycl::gpu_selector{}}, 1 << 16);
+}
@@ -1,2 +1,103 @@
 #include <gtest/gtest.h>
 #include <cooperative_groups.hpp>
+#include <usm_smart_ptr.hpp>
+
+using namespace usm_smart_ptr;
+
+void check_split_barrier(sycl::queue q) {
+    auto kernel_occupancy = get_occupancy<class split_barrier_kernel>(q);
+    auto kernel_range = kernel_occupancy.get_nd_range(nd_range_barrier<1>::max_group_count);
+    const size_t group_count = kernel_range.get_group_range().size();
+    auto grid_barrier = nd_range_barrier<1>::make_barrier(q, kernel_range, {}, kernel_occupancy.groups_per_compute_unit);
+    auto written = usm_unique_ptr<size_t, alloc::shared>(group_count, q);
+    auto seen = usm_unique_ptr<size_t, alloc::shared>(group_count, q);
+    q.fill(written.get(), size_t(0), group_count).wait();
+
+    q.parallel_for<class split_barrier_kernel>(kernel_range, [=, written = written.get(), seen = seen.get()](sycl::nd_item<1> it) {
+        const size_t group_id = it.get_group_linear_id();
+        for (size_t round = 1; round <= 4; ++round) {
+            if (it.get_local_linear_id() == 0) written[group_id] = round;
+            auto token = grid_barrier->arrive(it);
+            grid_barrier->wait(it, token);
+            if (it.get_local_linear_id() == 0) seen[group_id] = written[(group_id + 1) % group_count];
+            grid_barrier->wait(it);
+        }
+    }).wait_and_throw();
+
+    for (size_t i = 0; i < group_count; ++i) {
+        ASSERT_EQ(seen.get()[i], 4);
+    }
+    sycl::free(grid_barrier, q);
+}
+
+void check_grid_collectives(sycl::queue q) {
+    auto kernel_occupancy = get_occupancy<class grid_collectives_kernel>(q);
+    auto kernel_range = kernel_occupancy.get_nd_range(nd_range_barrier<1>::max_group_count);
+    const size_t global_size = kernel_range.get_global_range().size();
+    auto collectives = nd_range_collectives<size_t, 1>::make_collectives(q, kernel_range, kernel_occupancy.groups_per_compute_unit);
+    auto errors = usm_unique_ptr<size_t, alloc::shared>(1, q);
+    *errors.get() = 0;
+
+    q.parallel_for<class grid_collectives_kernel>(kernel_range, [=, errors = errors.get()](sycl::nd_item<1> it) {
+        const size_t id = it.get_global_linear_id();
+        for (int round = 0; round < 3; ++round) {
+            size_t sum = grid_reduce(it, collectives, size_t(1), sycl::plus<>());
+            size_t offset = grid_exclusive_scan(it, collectives, size_t(1), sycl::plus<>());
+            size_t root = grid_broadcast(it, collectives, it.get_group_linear_id(), it.get_group_range().size() - 1);
+            if (sum != global_size || offset != id || root != it.get_group_range().size() - 1) {
+                sycl::atomic_ref<size_t, sycl::memory_order::relaxed, sycl::memory_scope::device> ref(*errors);
+                ref.fetch_add(1);
+            }
+        }
+    }).wait_and_throw();
+
+    ASSERT_EQ(*errors.get(), 0);
+    nd_range_collectives<size_t, 1>::free_collectives(collectives, q);
+}
+
+template<typename lockable>
+class lock_kernel;
+
+template<typename lockable, typename... Args>
+void check_lock(sycl::queue q, Args... args) {
+    auto kernel_range = get_max_occupancy<lock_kernel<lockable>>(q);
+    auto lock = new(sycl::malloc_shared<lockable>(1, q)) lockable(args...);
+    auto counter = usm_unique_ptr<size_t, alloc::shared>(1, q);
+    *counter.get() = 0;
+
+    q.parallel_for<lock_kernel<lockable>>(kernel_range, [=, counter = counter.get()](sycl::nd_item<1> it) {
+        for (int i = 0; i < 16; ++i) {
+            if constexpr (std::is_same_v<lockable, device_semaphore>) {
+                group_acquire(it, *lock);
+            } else {
+                group_lock(it, *lock);
+            }
+            if (it.get_local_linear_id() == 0) {
+                volatile size_t *ptr = counter;
+                *ptr = *ptr + 1; // Not atomic, protected by the lock
+            }
+            if constexpr (std::is_same_v<lockable, device_semaphore>) {
+                group_release(it, *lock);
+            } else {
+                group_unlock(it, *lock);
+            }
+        }
+    }).wait_and_throw();
+
+    ASSERT_EQ(*counter.get(), 16 * kernel_range.get_group_range().size());
+    sycl::free(lock, q);
+}
+
+TEST(cooperative_groups, locks) {
+    check_lock<device_mutex>(sycl::queue{sycl::gpu_selector{}});
+    check_lock<ticket_lock>(sycl::queue{sycl::gpu_selector{}});
+    check_lock<device_semaphore>(sycl::queue{sycl::gpu_selector{}}, 1);
+}
+
+TEST(cooperative_groups, grid_collectives) {
+    check_grid_collectives(sycl::queue{sycl::gpu_selector{}});
+}
+
+TEST(cooperative_groups, split_barrier) {
+    check_split_barrier(sycl::queue{sycl::gpu_selector{}});
+}
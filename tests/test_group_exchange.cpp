@@ -0,0 +1,59 @@
+#include <gtest/gtest.h>
+#include <group_exchange.hpp>
+#include <usm_smart_ptr.hpp>
+
+using namespace usm_smart_ptr;
+
+constexpr size_t items_per_work_item = 4;
+
+template<bool padded>
+class group_exchange_kernel;
+
+template<bool padded>
+void check_group_exchange(sycl::queue q) {
+    using sycl::ext::exchange_direction;
+    constexpr size_t K = items_per_work_item;
+    const size_t group_size = 128;
+    auto errors = usm_unique_ptr<size_t, alloc::shared>(1, q);
+    *errors.get() = 0;
+
+    q.submit([&](sycl::handler &cgh) {
+        sycl::accessor<uint32_t, 1, sycl::access::mode::read_write, sycl::access::target::local> local_mem(sycl::range<1>(sycl::ext::group_exchange_local_size<uint32_t, K, padded>(group_size)), cgh);
+        cgh.parallel_for<group_exchange_kernel<padded>>(sycl::nd_range<1>(4 * group_size, group_size), [=, errors = errors.get()](sycl::nd_item<1> it) {
+            const auto sg = it.get_sub_group();
+            const auto sg_size = (uint32_t) sg.get_local_range().size();
+            const auto lane = (uint32_t) sg.get_local_linear_id();
+            const auto id = (uint32_t) it.get_local_linear_id();
+            uint32_t *shared = local_mem.get_pointer();
+            bool ok = true;
+
+            std::array<uint32_t, K> items{};
+            for (uint32_t i = 0; i < K; ++i) items[i] = lane * K + i;
+            sycl::ext::sub_group_exchange<exchange_direction::blocked_to_striped>(sg, items);
+            for (uint32_t i = 0; i < K; ++i) ok = ok && items[i] == i * sg_size + lane;
+            sycl::ext::sub_group_exchange<exchange_direction::striped_to_blocked>(sg, items);
+            for (uint32_t i = 0; i < K; ++i) ok = ok && items[i] == lane * K + i;
+
+            for (uint32_t i = 0; i < K; ++i) items[i] = id * K + i;
+            sycl::ext::group_exchange<exchange_direction::blocked_to_striped, padded>(it, shared, items);
+            for (uint32_t i = 0; i < K; ++i) ok = ok && items[i] == i * group_size + id;
+            sycl::ext::group_exchange<exchange_direction::striped_to_blocked, padded>(it, shared, items);
+            for (uint32_t i = 0; i < K; ++i) ok = ok && items[i] == id * K + i;
+
+            if (!ok) {
+                sycl::atomic_ref<size_t, sycl::memory_order::relaxed, sycl::memory_scope::device> ref(*errors);
+                ref.fetch_add(1);
+            }
+        });
+    }).wait_and_throw();
+
+    ASSERT_EQ(*errors.get(), 0);
+}
+
+TEST(group_exchange, padded) {
+    check_group_exchange<true>(sycl::queue{sycl::gpu_selector{}});
+}
+
+TEST(group_exchange, unpadded) {
+    check_group_exchange<false>(sycl::queue{sycl::gpu_selector{}});
+}
@@ -0,0 +1,67 @@
+#include <gtest/gtest.h>
+#include <group_load_store.hpp>
+#include <usm_smart_ptr.hpp>
+
+using namespace usm_smart_ptr;
+using sycl::ext::load_store_mode;
+
+template<load_store_mode mode>
+class load_store_kernel;
+
+/**
+ * Copies a buffer whose length is not a multiple of the tile size, checking the register layout of each mode.
+ */
+template<load_store_mode mode>
+void check_group_load_store(sycl::queue q) {
+    constexpr size_t K = 4;
+    const size_t group_size = 64, group_count = 8, length = group_count * group_size * K - 37;
+    auto in = usm_unique_ptr<uint32_t, alloc::shared>(length, q);
+    auto out = usm_unique_ptr<uint32_t, alloc::shared>(length + 1, q);
+    auto errors = usm_unique_ptr<size_t, alloc::shared>(1, q);
+    for (size_t i = 0; i < length; ++i) in.get()[i] = (uint32_t) i;
+    q.fill(out.get(), uint32_t(0xFFFFFFFF), length + 1).wait();
+    *errors.get() = 0;
+
+    q.submit([&](sycl::handler &cgh) {
+        sycl::accessor<uint32_t, 1, sycl::access::mode::read_write, sycl::access::target::local> local_mem(sycl::range<1>(sycl::ext::group_load_store_local_size<uint32_t, K, mode>(group_size) + 1), cgh);
+        cgh.parallel_for<load_store_kernel<mode>>(sycl::nd_range<1>(group_count * group_size, group_size), [=, in = in.get(), out = out.get(), errors = errors.get()](sycl::nd_item<1> it) {
+            uint32_t *shared = local_mem.get_pointer();
+            const size_t id = it.get_local_linear_id();
+            const size_t offset = it.get_group_linear_id() * group_size * K;
+            std::array<uint32_t, K> items{};
+            sycl::ext::group_load<K, mode, 2>(it, in + offset, length - offset, items, uint32_t(0xDEADBEEF), shared);
+            bool ok = true;
+            for (size_t k = 0; k < K; ++k) {
+                const size_t idx = offset + (mode == load_store_mode::striped ? k * group_size + id : id * K + k);
+                ok = ok && items[k] == (idx < length ? idx : 0xDEADBEEF);
+            }
+            if (!ok) {
+                sycl::atomic_ref<size_t, sycl::memory_order::relaxed, sycl::memory_scope::device> ref(*errors);
+                ref.fetch_add(1);
+            }
+            sycl::ext::group_store<K, mode>(it, out + offset, length - offset, items, shared);
+        });
+    }).wait_and_throw();
+
+    ASSERT_EQ(*errors.get(), 0);
+    for (size_t i = 0; i < length; ++i) {
+        ASSERT_EQ(out.get()[i], i);
+    }
+    ASSERT_EQ(out.get()[length], 0xFFFFFFFF);
+}
+
+TEST(group_load_store, direct) {
+    check_group_load_store<load_store_mode::direct>(sycl::queue{sycl::gpu_selector{}});
+}
+
+TEST(group_load_store, striped) {
+    check_group_load_store<load_store_mode::striped>(sycl::queue{sycl::gpu_selector{}});
+}
+
+TEST(group_load_store, vectorized) {
+    check_group_load_store<load_store_mode::vectorized>(sycl::queue{sycl::gpu_selector{}});
+}
+
+TEST(group_load_store, transpose) {
+    check_group_load_store<load_store_mode::transpose>(sycl::queue{sycl::gpu_selector{}});
+}
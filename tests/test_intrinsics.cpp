@@ -1,5 +1,7 @@
 #include <gtest/gtest.h>
 #include <intrinsics.hpp>
+#include <limits>
+#include <utility>
 
 #define SYCL_ASSERT(x) \
 if(!(x)) {volatile int * ptr = nullptr ; *ptr;}
@@ -25,6 +27,35 @@ void check_builtins() {
 
     SYCL_ASSERT(sycl::ext::upsample<unsigned char>('S', 'Y', 'C', 'L') == 0x5359434c)
 
+    SYCL_ASSERT(sycl::ext::funnelshift_l(lo, hi, 40) == 0xADBEEFCA)
+    SYCL_ASSERT(sycl::ext::funnelshift_r(lo, hi, 31) == ((lo >> 31) | (hi << 1)))
+    SYCL_ASSERT(sycl::ext::funnelshift_l64(0xCAFED00Dul << 32, 0xDEADBEEFul, 8) == 0xDEADBEEFCAul)
+    SYCL_ASSERT(sycl::ext::funnelshift_r64(0, 0xDEADBEEFul, 0) == 0)
+    SYCL_ASSERT(sycl::ext::rotl32(0x80000001u, 1) == 3u)
+    SYCL_ASSERT(sycl::ext::rotr64(3ul, 1) == 0x8000000000000001ul)
+
+    SYCL_ASSERT(sycl::ext::clz32(0) == 32 && sycl::ext::clz32(1) == 31 && sycl::ext::clz64(1) == 63)
+    SYCL_ASSERT(sycl::ext::ctz32(0) == 32 && sycl::ext::ctz64(1ul << 40) == 40)
+    SYCL_ASSERT(sycl::ext::popc32(lo) == 17 && sycl::ext::popc64(~0ul) == 64)
+    SYCL_ASSERT(sycl::ext::ffs32(0) == 0 && sycl::ext::ffs32(8) == 4 && sycl::ext::ffs64(1ul << 40) == 41)
+    SYCL_ASSERT(sycl::ext::bfind32(0) == 0xFFFFFFFF && sycl::ext::bfind32(hi) == 31 && sycl::ext::bfind64(1ul << 40) == 40)
+
+    SYCL_ASSERT(sycl::ext::bfe(hi, 8, 8) == 0xBE && sycl::ext::bfe(hi, 0, 32) == hi && sycl::ext::bfe(hi, 4, 0) == 0)
+    SYCL_ASSERT(sycl::ext::bfe(int32_t(0xF000), 12, 4) == -1 && sycl::ext::bfe(int64_t(0x7000), 12, 4) == 7)
+    SYCL_ASSERT(sycl::ext::bfi(0xFFu, hi, 4, 8) == 0xDEADBFFF)
+    SYCL_ASSERT(sycl::ext::bfi(uint64_t(lo), uint64_t(hi) << 32, 0, 32) == ((uint64_t(hi) << 32) | lo))
+    SYCL_ASSERT(sycl::ext::byte_perm(0x33221100u, 0x77665544u, 0x7531u) == 0x77553311u)
+    SYCL_ASSERT(sycl::ext::byte_perm(lo, hi, 0x0123u) == 0x0DD0FECA)
+    SYCL_ASSERT(sycl::ext::get_byte(hi, 3) == 0xDE && sycl::ext::set_byte(hi, 0x00, 3) == 0x00ADBEEF)
+
+    SYCL_ASSERT(sycl::ext::vadd4(0xFF017F80u, 0x01017F80u) == 0x0002FE00u && sycl::ext::vadd2(0xFFFF0001u, 0x00010001u) == 0x00000002u)
+    SYCL_ASSERT(sycl::ext::vsub4(0x00027F80u, 0x01017F81u) == 0xFF0100FFu && sycl::ext::vsub2(0x00000002u, 0x00010001u) == 0xFFFF0001u)
+    SYCL_ASSERT(sycl::ext::vabsdiff4(0x10F00080u, 0xF0100180u) == 0xE0E00100u && sycl::ext::vabsdiff2(0x0010FFF0u, 0xFFF00010u) == 0xFFE0FFE0u)
+    SYCL_ASSERT(sycl::ext::vmax4(0x10F00080u, 0xF0100180u) == 0xF0F00180u && sycl::ext::vmax2(0x0010FFF0u, 0xFFF00010u) == 0xFFF0FFF0u)
+    SYCL_ASSERT(sycl::ext::vcmpeq4(hi, 0xDE00BE00u) == 0xFF00FF00u && sycl::ext::vcmpeq2(hi, 0xDEADBE00u) == 0xFFFF0000u)
+    SYCL_ASSERT(sycl::ext::dp4a(0x01020304u, 0x01010101u, 10u) == 20u && sycl::ext::dp4a(int32_t(0xFF02FF04), int32_t(0x01010101), 0) == 4)
+    SYCL_ASSERT(sycl::ext::dp2a_lo(0x00020003u, 0x01010504u, 1u) == 23u && sycl::ext::dp2a_hi(0x00020003u, 0x01010504u, 1u) == 6u)
+
 
 }
 
@@ -36,6 +67,7 @@ void check_builtins(sycl::queue q) {
         check_builtins();
     }).wait_and_throw();
 
+    int *global_val = sycl::malloc_device<int>(1, q);
     q.parallel_for<class tests2>(sycl::nd_range<1>(32, 32), [=](sycl::nd_item<1> it) {
         check_builtins();
         if (is_host) return;
@@ -52,19 +84,52 @@ void check_builtins(sycl::queue q) {
 
         SYCL_ASSERT(sycl::ext::match_all(sg, mask_even, it.get_local_linear_id() % 2))
 
-        uint32_t expected = (it.get_local_linear_id() % 2 == 0) ? mask_even : mask_odd;
+        sycl::ext::sub_group_mask_t<> expected = (it.get_local_linear_id() % 2 == 0) ? mask_even : mask_odd;
         SYCL_ASSERT(expected == sycl::ext::match_any(sg, it.get_local_linear_id() % 2 == 0))
+        SYCL_ASSERT(mask_even == sycl::ext::ballot(sg, it.get_local_linear_id() % 2 == 0))
+        const size_t lane_class = it.get_local_linear_id() % 3;
+        SYCL_ASSERT(sycl::ext::predicate_to_mask(sg, [&](size_t i) { return i % 3 == lane_class; }) == sycl::ext::match_any(sg, lane_class))
+        const float nan_on_odd = it.get_local_linear_id() % 2 ? std::numeric_limits<float>::quiet_NaN() : 1.f; // NaN never matches, not even itself
+        expected = (it.get_local_linear_id() % 2 == 0) ? mask_even : sycl::ext::sub_group_mask_t<>{1} << it.get_local_linear_id();
+        SYCL_ASSERT(expected == sycl::ext::match_any<float>(sg, nan_on_odd))
+        SYCL_ASSERT(uint32_t(mask_odd) == sycl::ext::ballot<32>(sg, it.get_local_linear_id() % 2 != 0))
+
+        sycl::ext::prefetch(global_val);
 
-        int val;
-        sycl::ext::prefetch(&val);
 
+    }).wait_and_throw();
+    sycl::free(global_val, q);
+}
 
+static_assert(sycl::ext::internal::is_hintable<uint64_t>());
+static_assert(!sycl::ext::internal::is_hintable<std::pair<int, int>>(), "Under-aligned types must use regular accesses");
+
+/**
+ * The cache hints only apply to global memory, the data goes through USM.
+ */
+void check_cache_hints(sycl::queue q) {
+    auto data = sycl::malloc_shared<uint64_t>(4, q);
+    auto words = sycl::malloc_shared<sycl::vec<uint64_t, 2>>(2, q);
+    data[0] = 0xDEADBEEFCAFED00D;
+    data[1] = 42;
+    words[0] = sycl::vec<uint64_t, 2>(1, 2);
+    q.single_task<class cache_hints>([=]() {
+        sycl::ext::store_streaming(data + 2, sycl::ext::load_streaming(data) + 1);
+        sycl::ext::store_streaming(data + 3, sycl::ext::load_readonly(data + 1) + 1);
+        sycl::ext::store_streaming(words + 1, sycl::ext::load_streaming(words)); // 16 bytes accesses
     }).wait_and_throw();
+    ASSERT_EQ(data[2], 0xDEADBEEFCAFED00E);
+    ASSERT_EQ(data[3], 43);
+    ASSERT_EQ(words[1][0], 1);
+    ASSERT_EQ(words[1][1], 2);
+    sycl::free(data, q);
+    sycl::free(words, q);
 }
 
 
 TEST(intrinsics, device) {
     check_builtins(sycl::queue{sycl::gpu_selector{}});
+    check_cache_hints(sycl::queue{sycl::gpu_selector{}});
     ASSERT_TRUE(true);
 }
 
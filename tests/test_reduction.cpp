@@ -9,6 +9,17 @@ void test_reduce_device(size_t size, sycl::queue q) {
     ASSERT_EQ(res, (size * (size - 1)) / 2);
 }
 
+/**
+ * 12 elements per work-item, streamed as a chunk of 8 and a remainder of 4
+ */
+void test_reduce_device_remainder(size_t size, sycl::queue q) {
+    using T = uint64_t;
+    auto in = usm_unique_ptr<T, alloc::shared>(size, q);
+    std::iota(in.get(), in.get() + in.size(), 0);
+    T res = parallel_primitives::dispatch_kernel_call<sycl::plus<>, T, 12>(q, in.get(), size, 64);
+    ASSERT_EQ(res, (size * (size - 1)) / 2);
+}
+
 void test_reduce_host(size_t size, sycl::queue q) {
     using T = uint64_t;
     auto in = std::vector<T>(size, T{});
@@ -24,6 +35,12 @@ TEST(reduction, device) {
     }
 }
 
+TEST(reduction, device_remainder) {
+    for (size_t i = 1; i < 100'000; i *= 4) {
+        test_reduce_device_remainder(i, sycl::queue{sycl::gpu_selector{}});
+    }
+}
+
 TEST(reduction, host) {
     for (size_t i = 1; i < 1'000'000; i *= 4) {
         test_reduce_host(i, sycl::queue{sycl::gpu_selector{}});
@@ -0,0 +1,78 @@
+#include <gtest/gtest.h>
+#include <register_sort.hpp>
+#include <algorithm>
+#include <random>
+
+using sycl::ext::register_sort;
+using sycl::ext::register_sort_by_key;
+using sycl::ext::sorting_network;
+using sycl::ext::sorting_network_size;
+
+static_assert(sorting_network_size<sorting_network::optimal, 1> == 0);
+static_assert(sorting_network_size<sorting_network::optimal, 4> == 5);
+static_assert(sorting_network_size<sorting_network::optimal, 8> == 19);
+static_assert(sorting_network_size<sorting_network::odd_even_merge, 8> == 19);
+static_assert(sorting_network_size<sorting_network::bitonic, 8> == 24);
+
+/**
+ * A network sorts every input if and only if it sorts every sequence of 0 and 1, which is exhaustive up to N = 16.
+ */
+template<sorting_network network, size_t N>
+void check_zero_one() {
+    for (uint32_t bits = 0; bits < (1u << N); ++bits) {
+        std::array<uint8_t, N> arr{};
+        for (size_t i = 0; i < N; ++i) arr[i] = (bits >> i) & 1;
+        register_sort<network>(arr);
+        ASSERT_TRUE(std::is_sorted(arr.begin(), arr.end())) << "N = " << N << ", input = " << bits;
+    }
+}
+
+template<sorting_network network, size_t... N>
+void check_zero_one_sizes(std::index_sequence<N...>) {
+    (check_zero_one<network, N + 1>(), ...);
+}
+
+template<sorting_network network, size_t N>
+void check_random() {
+    std::mt19937 gen(N);
+    std::uniform_int_distribution<int> dist(-100, 100);
+    for (int repeat = 0; repeat < 100; ++repeat) {
+        std::array<int, N> arr{};
+        int c_arr[N];
+        for (size_t i = 0; i < N; ++i) c_arr[i] = arr[i] = dist(gen);
+        auto expected = arr;
+        std::sort(expected.begin(), expected.end(), std::greater<>{});
+
+        register_sort<network>(arr, std::greater<>{});
+        register_sort<network>(c_arr, std::greater<>{});
+        ASSERT_EQ(arr, expected);
+        ASSERT_TRUE(std::equal(expected.begin(), expected.end(), c_arr));
+    }
+}
+
+TEST(register_sort, networks) {
+    check_zero_one_sizes<sorting_network::optimal>(std::make_index_sequence<16>{});
+    check_zero_one_sizes<sorting_network::odd_even_merge>(std::make_index_sequence<16>{});
+    check_zero_one_sizes<sorting_network::bitonic>(std::make_index_sequence<16>{});
+    check_random<sorting_network::optimal, 7>();
+    check_random<sorting_network::odd_even_merge, 33>();
+    check_random<sorting_network::bitonic, 64>();
+}
+
+TEST(register_sort, by_key) {
+    std::array<uint32_t, 10> keys{9, 3, 7, 1, 8, 2, 6, 0, 5, 4};
+    std::array<uint32_t, 10> values{};
+    for (size_t i = 0; i < keys.size(); ++i) values[i] = 10 * keys[i];
+    register_sort_by_key(keys, values);
+    for (uint32_t i = 0; i < keys.size(); ++i) {
+        ASSERT_EQ(keys[i], i);
+        ASSERT_EQ(values[i], 10 * i);
+    }
+
+    float distances[5] = {0.5f, 0.1f, 0.4f, 0.2f, 0.3f};
+    int ids[5] = {5, 1, 4, 2, 3};
+    register_sort_by_key<sorting_network::bitonic>(distances, ids); // Top-k by distance
+    for (int i = 0; i < 5; ++i) {
+        ASSERT_EQ(ids[i], i + 1);
+    }
+}
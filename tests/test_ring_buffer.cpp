@@ -0,0 +1,60 @@
+#include <gtest/gtest.h>
+#include <ring_buffer.hpp>
+#include <cooperative_groups.hpp>
+#include <usm_smart_ptr.hpp>
+
+using namespace usm_smart_ptr;
+
+/**
+ * Producers and consumers in the same persistent kernel, the ring buffer being smaller than the data.
+ */
+void check_ring_buffer(sycl::queue q, bool use_sub_group) {
+    auto kernel_occupancy = get_occupancy<class ring_buffer_kernel>(q);
+    auto kernel_range = kernel_occupancy.get_nd_range(nd_range_barrier<1>::max_group_count);
+    const size_t global_size = kernel_range.get_global_range().size();
+    auto grid_barrier = nd_range_barrier<1>::make_barrier(q, kernel_range, {}, kernel_occupancy.groups_per_compute_unit);
+    auto ring_buffer = mpmc_ring_buffer<uint32_t>::make_ring_buffer(q, global_size / 2 + 1);
+    auto popped = usm_unique_ptr<uint32_t, alloc::shared>(global_size, q);
+    q.fill(popped.get(), uint32_t(0), global_size).wait();
+
+    q.parallel_for<class ring_buffer_kernel>(kernel_range, [=, popped = popped.get()](sycl::nd_item<1> it) {
+        const auto id = (uint32_t) it.get_global_linear_id();
+        bool to_push = true;
+        for (int round = 0; round < 4; ++round) {
+            uint32_t value = 0;
+            bool pushed, has_popped;
+            if (use_sub_group) {
+                pushed = ring_buffer->try_push(it.get_sub_group(), id, to_push);
+            } else {
+                pushed = to_push && ring_buffer->try_push(id);
+            }
+            to_push = to_push && !pushed;
+            grid_barrier->wait(it);
+            if (use_sub_group) {
+                has_popped = ring_buffer->try_pop(it.get_sub_group(), value);
+            } else {
+                has_popped = ring_buffer->try_pop(value);
+            }
+            if (has_popped) {
+                sycl::atomic_ref<uint32_t, sycl::memory_order::relaxed, sycl::memory_scope::device> ref(popped[value]);
+                ref.fetch_add(1);
+            }
+            grid_barrier->wait(it);
+        }
+    }).wait_and_throw();
+
+    ASSERT_EQ(ring_buffer->size(), 0);
+    for (size_t i = 0; i < global_size; ++i) {
+        ASSERT_EQ(popped.get()[i], 1);
+    }
+    mpmc_ring_buffer<uint32_t>::free_ring_buffer(ring_buffer, q);
+    sycl::free(grid_barrier, q);
+}
+
+TEST(ring_buffer, work_item) {
+    check_ring_buffer(sycl::queue{sycl::gpu_selector{}}, false);
+}
+
+TEST(ring_buffer, sub_group) {
+    check_ring_buffer(sycl::queue{sycl::gpu_selector{}}, true);
+}
@@ -4,6 +4,7 @@
 
 using sycl::ext::runtime_index_wrapper;
 using sycl::ext::runtime_index_wrapper_log;
+using sycl::ext::runtime_scatter;
 constexpr uint size = 64;
 
 /**
@@ -261,4 +262,149 @@ TEST(runtime_byte_array, array) {
     check_byte_array<uint8_t, 20>();
     check_byte_array<uint8_t, 30>();
     check_byte_array<uint8_t, 40>();
-}
\ No newline at end of file
+}
+
+template<sycl::ext::registerizer_strategy strategy, size_t N>
+void check_strategy() {
+    std::array<size_t, N> arr{};
+    for (uint i = 0; i < N; ++i) {
+        runtime_index_wrapper<strategy>(arr, i, 3 * i + 1);
+    }
+    runtime_index_wrapper<strategy>(arr, N, 0); // Out of range, ignored
+    for (uint i = 0; i < N; ++i) {
+        ASSERT_EQ(runtime_index_wrapper<strategy>(arr, i), 3 * i + 1);
+    }
+
+    std::vector<size_t> vec(N, 0);
+    sycl::ext::runtime_wrapper<std::vector<size_t>, strategy> acc(vec);
+    for (uint i = 0; i < N; ++i) {
+        acc.template write<N>(i, i);
+    }
+    for (uint i = 0; i < N; ++i) {
+        ASSERT_EQ(acc.template read<N>(i), i);
+    }
+}
+
+TEST(runtime_index_wrapper, strategies) {
+    using sycl::ext::registerizer_strategy;
+    check_strategy<registerizer_strategy::linear, 1>();
+    check_strategy<registerizer_strategy::linear, 17>();
+    check_strategy<registerizer_strategy::linear, 100>();
+    check_strategy<registerizer_strategy::switch_case, 1>();
+    check_strategy<registerizer_strategy::switch_case, 17>();
+    check_strategy<registerizer_strategy::switch_case, 100>();
+    check_strategy<registerizer_strategy::binary_search, 1>();
+    check_strategy<registerizer_strategy::binary_search, 17>();
+    check_strategy<registerizer_strategy::binary_search, 100>();
+    check_strategy<registerizer_strategy::stack, 17>();
+    check_strategy<registerizer_strategy::automatic, 1>();
+    check_strategy<registerizer_strategy::automatic, 17>();
+    check_strategy<registerizer_strategy::automatic, 1000>();
+}
+
+TEST(runtime_index_wrapper, automatic_strategy) {
+    using sycl::ext::registerizer_strategy;
+    using sycl::ext::select_registerizer_strategy;
+    static_assert(select_registerizer_strategy<uint32_t, 1>() == registerizer_strategy::linear);
+    static_assert(select_registerizer_strategy<uint32_t, 17>() == registerizer_strategy::binary_search);
+    static_assert(select_registerizer_strategy<uint32_t, 100000>() == registerizer_strategy::binary_search, "No stack fallback without measured crossovers");
+    static_assert(sycl::ext::select_register_only_strategy<uint32_t, 100000>() == registerizer_strategy::binary_search);
+
+    std::array<uint32_t, 300> arr{};
+    auto acc = sycl::ext::make_runtime_wrapper<registerizer_strategy::automatic>(arr);
+    for (uint i = 0; i < arr.size(); ++i) {
+        acc.write(i, i + 1);
+    }
+    for (uint i = 0; i < arr.size(); ++i) {
+        ASSERT_EQ(acc[i], i + 1);
+    }
+}
+
+void check_gather_scatter() {
+    std::array<size_t, size> arr{};
+    runtime_scatter(arr, std::array<uint, 4>{3, 7, 7, size}, std::array<uint, 4>{1, 2, 3, 4}); // Last duplicate wins, out of range ignored
+    ASSERT_EQ(arr[3], 1);
+    ASSERT_EQ(arr[7], 3);
+    for (uint i = 0; i < size; ++i) {
+        runtime_index_wrapper(arr, i, 2 * i);
+    }
+
+    for (uint i = 0; i + 3 < size; ++i) {
+        const auto values = sycl::ext::runtime_gather(arr, i, i + 3, size - 1 - i);
+        ASSERT_EQ(values[0], 2 * i);
+        ASSERT_EQ(values[1], 2 * (i + 3));
+        ASSERT_EQ(values[2], 2 * (size - 1 - i));
+    }
+
+    sycl::uint16 vec;
+    sycl::ext::runtime_wrapper acc(vec);
+    acc.scatter(std::array<uint, 16>{0, 1, 2, 3, 4, 5, 6, 7, 8, 9, 10, 11, 12, 13, 14, 15}, std::array<uint, 16>{15, 14, 13, 12, 11, 10, 9, 8, 7, 6, 5, 4, 3, 2, 1, 0});
+    const auto values = acc.gather(std::array<uint, 2>{0, 15});
+    ASSERT_EQ(values[0], 15);
+    ASSERT_EQ(values[1], 0);
+}
+
+TEST(runtime_index_wrapper, gather_scatter) {
+    check_gather_scatter();
+}
+
+template<sycl::ext::registerizer_strategy strategy, size_t R, size_t C>
+void check_2d() {
+    using sycl::ext::runtime_index_wrapper_2d;
+    std::array<std::array<uint32_t, C>, R> tile{};
+    uint32_t c_tile[R][C] = {};
+    for (uint r = 0; r < R; ++r) {
+        for (uint c = 0; c < C; ++c) {
+            runtime_index_wrapper_2d<strategy>(tile, r, c, r * C + c);
+            runtime_index_wrapper_2d<strategy>(c_tile, r, c, r * C + c);
+        }
+    }
+    runtime_index_wrapper_2d<strategy>(tile, 0, C, 1000); // Column out of range, must not alias the next row
+    runtime_index_wrapper_2d<strategy>(tile, R, 0, 1000); // Row out of range, ignored
+    ASSERT_EQ(runtime_index_wrapper_2d<strategy>(tile, R + 1, C + 1), tile[0][0]); // Out of range reads (0, 0)
+    for (uint r = 0; r < R; ++r) {
+        for (uint c = 0; c < C; ++c) {
+            ASSERT_EQ(tile[r][c], r * C + c);
+            ASSERT_EQ(runtime_index_wrapper_2d<strategy>(tile, r, c), r * C + c);
+            ASSERT_EQ(runtime_index_wrapper_2d<strategy>(c_tile, r, c), r * C + c);
+        }
+    }
+
+    for (uint c = 0; c < C; ++c) {
+        ASSERT_EQ((sycl::ext::runtime_index_wrapper_2d_fixed_row<R - 1, strategy>(c_tile, c)), (R - 1) * C + c);
+        sycl::ext::runtime_index_wrapper_2d_fixed_row<0, strategy>(c_tile, c, 7);
+        ASSERT_EQ(c_tile[0][c], 7);
+    }
+    for (uint r = 0; r < R; ++r) {
+        ASSERT_EQ((sycl::ext::runtime_index_wrapper_2d_fixed_col<C - 1, strategy>(tile, r)), r * C + C - 1);
+        sycl::ext::runtime_index_wrapper_2d_fixed_col<0, strategy>(c_tile, r, 0);
+        ASSERT_EQ(c_tile[r][0], 0);
+    }
+
+    sycl::ext::runtime_wrapper<decltype(tile), strategy> acc(tile);
+    acc.write(R - 1, C - 1, 42);
+    ASSERT_EQ(acc(R - 1, C - 1), 42);
+    ASSERT_EQ(acc.template read_fixed_row<R - 1>(C - 1), 42);
+    ASSERT_EQ(acc.template read_fixed_col<C - 1>(R - 1), 42);
+
+    const auto last_row = acc.read(R - 1); // Whole rows, as with the 1D wrapper
+    ASSERT_EQ(last_row[C - 1], 42);
+    acc.write(0, last_row);
+    ASSERT_EQ(acc[0][C - 1], 42);
+}
+
+TEST(runtime_index_wrapper, array_2d) {
+    using sycl::ext::registerizer_strategy;
+    check_2d<registerizer_strategy::linear, 8, 8>();
+    check_2d<registerizer_strategy::linear, 3, 5>();
+    check_2d<registerizer_strategy::switch_case, 5, 3>();
+    check_2d<registerizer_strategy::binary_search, 8, 8>();
+    check_2d<registerizer_strategy::stack, 4, 6>();
+    check_2d<registerizer_strategy::automatic, 1, 1>();
+    check_2d<registerizer_strategy::automatic, 16, 16>();
+
+    uint32_t dp[4][4] = {};
+    sycl::ext::runtime_wrapper acc(dp); // Deduces the 2D accessor
+    acc.write(2, 3, 5u);
+    ASSERT_EQ(acc(2, 3), 5u);
+}
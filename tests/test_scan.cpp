@@ -57,4 +57,33 @@ float wallis_product_pi(sycl::queue &q) {
     }
 
     return out[arr_size - 1];
-}
\ No newline at end of file
+}
+
+template<parallel_primitives::scan_type type>
+void check_group_scan_algorithm(sycl::queue q, parallel_primitives::group_scan_algorithm algorithm, size_t length) {
+    using namespace parallel_primitives;
+    std::vector<uint32_t> in(length), expected(length), out(length);
+    for (size_t i = 0; i < length; ++i) in[i] = (uint32_t) (i % 7);
+    host_scan<type, sycl::plus<>>(in.data(), expected.data(), length);
+
+    auto d_in = usm_unique_ptr<uint32_t, alloc::device>(length, q);
+    auto d_out = usm_unique_ptr<uint32_t, alloc::device>(length, q);
+    q.memcpy(d_in.get(), in.data(), d_in.size_bytes()).wait();
+
+    scan_device<type, sycl::plus<>>(q, d_in.get(), d_out.get(), length, algorithm);
+    q.memcpy(out.data(), d_out.get(), d_out.size_bytes()).wait();
+    ASSERT_EQ(out, expected);
+
+    decoupled_scan_device<type, sycl::plus<>, uint32_t, false>(q, d_in.get(), d_out.get(), length, algorithm);
+    q.memcpy(out.data(), d_out.get(), d_out.size_bytes()).wait();
+    ASSERT_EQ(out, expected);
+}
+
+TEST(scan, group_scan_algorithms) {
+    using namespace parallel_primitives;
+    sycl::queue q{sycl::gpu_selector{}};
+    for (auto algorithm: {group_scan_algorithm::sycl_joint, group_scan_algorithm::raking}) {
+        check_group_scan_algorithm<scan_type::inclusive>(q, algorithm, 1'000'003);
+        check_group_scan_algorithm<scan_type::exclusive>(q, algorithm, 1'000'003);
+    }
+}
@@ -0,0 +1,51 @@
+#include <gtest/gtest.h>
+#include <sub_group_array.hpp>
+#include <usm_smart_ptr.hpp>
+
+using namespace usm_smart_ptr;
+
+class sub_group_array_kernel;
+
+/**
+ * Work-groups of 64 work-items so that the sub-groups are full whatever their size.
+ */
+void check_sub_group_array(sycl::queue q) {
+    constexpr size_t N = 200;
+    constexpr uint32_t modified = 123;
+    auto table = usm_unique_ptr<uint32_t, alloc::shared>(N, q);
+    auto errors = usm_unique_ptr<size_t, alloc::shared>(1, q);
+    for (size_t e = 0; e < N; ++e) table.get()[e] = (uint32_t) (3 * e + 1);
+    *errors.get() = 0;
+
+    q.parallel_for<sub_group_array_kernel>(sycl::nd_range<1>(64 * 4, 64), [=, table = table.get(), errors = errors.get()](sycl::nd_item<1> it) {
+        const auto sg = it.get_sub_group();
+        const auto lane = (uint32_t) sg.get_local_linear_id();
+        sycl::ext::sub_group_array<uint32_t, N> arr; // 25 slots with the default, enough for any sub-group of 8 or more work-items
+        arr.load(sg, table);
+
+        size_t local_errors = 0;
+        for (uint32_t k = 0; k < N; ++k) {
+            const uint32_t i = (lane * 7 + k) % N; // Divergent
+            local_errors += arr.read(sg, i) != 3 * i + 1;
+            local_errors += arr.read_uniform(sg, k) != 3 * k + 1;
+        }
+
+        arr.write_uniform(sg, N - 1, modified);
+        local_errors += arr.read(sg, N - 1 - lane % 2) != (lane % 2 ? 3 * (N - 2) + 1 : modified);
+
+        if (local_errors != 0) {
+            sycl::atomic_ref<size_t, sycl::memory_order::relaxed, sycl::memory_scope::device> ref(*errors);
+            ref.fetch_add(local_errors);
+        }
+    }).wait_and_throw();
+
+    ASSERT_EQ(*errors.get(), 0);
+}
+
+static_assert(sycl::ext::sub_group_array<uint32_t, 200>::fits(8));
+static_assert(!sycl::ext::sub_group_array<uint32_t, 200, 32>::fits(16), "7 slots of 16 lanes hold 112 elements");
+static_assert(sycl::ext::sub_group_array<uint32_t, 200, 32>::slots == 7, "A required sub-group size of 32 only allocates the slots it uses");
+
+TEST(sub_group_array, read_write) {
+    check_sub_group_array(sycl::queue{sycl::gpu_selector{}});
+}
@@ -0,0 +1,47 @@
+#include <gtest/gtest.h>
+#include <parallel_primitives/sub_group_scan.hpp>
+#include <usm_smart_ptr.hpp>
+
+using namespace usm_smart_ptr;
+using namespace parallel_primitives;
+
+template<sub_group_algorithm algorithm>
+class sub_group_scan_kernel;
+
+/**
+ * Work-groups of 48 work-items, so that the last sub-group may be partial.
+ */
+template<sub_group_algorithm algorithm>
+void check_sub_group_scan(sycl::queue q) {
+    auto errors = usm_unique_ptr<size_t, alloc::shared>(1, q);
+    *errors.get() = 0;
+
+    q.parallel_for<sub_group_scan_kernel<algorithm>>(sycl::nd_range<1>(48 * 16, 48), [=, errors = errors.get()](sycl::nd_item<1> it) {
+        const auto sg = it.get_sub_group();
+        const auto lane = (uint32_t) sg.get_local_linear_id();
+        const auto size = (uint32_t) sg.get_local_range().size();
+        const uint32_t value = lane + 1;
+        const uint32_t inclusive = sub_group_scan<scan_type::inclusive, algorithm>(sg, value, sycl::plus<uint32_t>());
+        const uint32_t exclusive = sub_group_scan<scan_type::exclusive, algorithm>(sg, value, sycl::plus<uint32_t>(), 10u);
+        const uint32_t reduced = sub_group_reduce<algorithm>(sg, value, sycl::plus<uint32_t>());
+        const uint32_t maximum = sub_group_reduce<algorithm>(sg, value, sycl::maximum<uint32_t>());
+        if (inclusive != (lane + 1) * (lane + 2) / 2 || exclusive != 10 + lane * (lane + 1) / 2 || reduced != size * (size + 1) / 2 || maximum != size) {
+            sycl::atomic_ref<size_t, sycl::memory_order::relaxed, sycl::memory_scope::device> ref(*errors);
+            ref.fetch_add(1);
+        }
+    }).wait_and_throw();
+
+    ASSERT_EQ(*errors.get(), 0);
+}
+
+TEST(sub_group_scan, sycl_builtin) {
+    check_sub_group_scan<sub_group_algorithm::sycl_builtin>(sycl::queue{sycl::gpu_selector{}});
+}
+
+TEST(sub_group_scan, kogge_stone) {
+    check_sub_group_scan<sub_group_algorithm::kogge_stone>(sycl::queue{sycl::gpu_selector{}});
+}
+
+TEST(sub_group_scan, brent_kung) {
+    check_sub_group_scan<sub_group_algorithm::brent_kung>(sycl::queue{sycl::gpu_selector{}});
+}
@@ -0,0 +1,62 @@
+#include <gtest/gtest.h>
+#include <work_queue.hpp>
+#include <cooperative_groups.hpp>
+#include <usm_smart_ptr.hpp>
+
+using namespace usm_smart_ptr;
+
+void check_work_queue(sycl::queue q, size_t work_count, size_t chunk_size) {
+    auto kernel_range = get_max_occupancy<class work_queue_kernel>(q);
+    auto work_queue = persistent_work_queue<1>::make_work_queue(q, work_count);
+    auto visited = usm_unique_ptr<uint32_t, alloc::shared>(work_count, q);
+    q.fill(visited.get(), uint32_t(0), work_count).wait();
+
+    q.parallel_for<class work_queue_kernel>(kernel_range, [=, visited = visited.get()](sycl::nd_item<1> it) {
+        work_queue->for_each_chunk(it, chunk_size, [&](size_t begin, size_t end) {
+            for (size_t i = begin + it.get_local_linear_id(); i < end; i += it.get_local_range().size()) {
+                visited[i]++;
+            }
+        });
+    }).wait_and_throw();
+
+    for (size_t i = 0; i < work_count; ++i) {
+        ASSERT_EQ(visited.get()[i], 1);
+    }
+    sycl::free(work_queue, q);
+}
+
+void check_weighted_work_queue(sycl::queue q, size_t item_count, size_t cost_per_chunk, bool empty_items = false) {
+    auto kernel_range = get_max_occupancy<class weighted_work_queue_kernel>(q);
+    auto offsets = usm_unique_ptr<size_t, alloc::shared>(item_count + 1, q);
+    auto visited = usm_unique_ptr<uint32_t, alloc::shared>(item_count, q);
+    q.fill(visited.get(), uint32_t(0), item_count).wait();
+    offsets.get()[0] = 0;
+    for (size_t i = 0; i < item_count; ++i) {
+        offsets.get()[i + 1] = offsets.get()[i] + (empty_items ? 0 : (i % 7) * (i % 3)); // Irregular costs, some of them empty
+    }
+    auto work_queue = persistent_work_queue<1>::make_work_queue(q, offsets.get()[item_count]);
+
+    q.parallel_for<class weighted_work_queue_kernel>(kernel_range, [=, offsets = offsets.get(), visited = visited.get()](sycl::nd_item<1> it) {
+        work_queue->for_each_weighted_chunk(it, offsets, item_count, cost_per_chunk, [&](size_t begin, size_t end) {
+            for (size_t i = begin + it.get_local_linear_id(); i < end; i += it.get_local_range().size()) {
+                visited[i]++;
+            }
+        });
+    }).wait_and_throw();
+
+    for (size_t i = 0; i < item_count; ++i) {
+        ASSERT_EQ(visited.get()[i], 1);
+    }
+    sycl::free(work_queue, q);
+}
+
+TEST(work_queue, fixed_chunks) {
+    check_work_queue(sycl::queue{sycl::gpu_selector{}}, 1'000'000, 4096);
+    check_work_queue(sycl::queue{sycl::gpu_selector{}}, 1'000, 7);
+}
+
+TEST(work_queue, weighted_chunks) {
+    check_weighted_work_queue(sycl::queue{sycl::gpu_selector{}}, 100'000, 1024);
+    check_weighted_work_queue(sycl::queue{sycl::gpu_selector{}}, 100, 1);
+    check_weighted_work_queue(sycl::queue{sycl::gpu_selector{}}, 100, 16, true);
+}